@@ -0,0 +1,23 @@
+var NodeGit = require("../../");
+var Repository = NodeGit.Repository;
+
+// Reads a blob of tens of megabytes into a Buffer.
+module.exports = {
+  fixture: "huge",
+
+  setup: function(repoPath) {
+    return Repository.open(repoPath).then(function(repository) {
+      return repository.getBranchCommit("master").then(function(commit) {
+        return commit.getEntry("huge.bin");
+      }).then(function(entry) {
+        return { repository: repository, oid: entry.sha() };
+      });
+    });
+  },
+
+  run: function(context) {
+    return context.repository.getBlob(context.oid).then(function(blob) {
+      return blob.content().length;
+    });
+  }
+};
@@ -0,0 +1,47 @@
+var Promise = require("nodegit-promise");
+var NodeGit = require("../../");
+var Repository = NodeGit.Repository;
+
+// Reads thousands of small blobs, all of them in flight at once.
+module.exports = {
+  fixture: "wide",
+
+  setup: function(repoPath) {
+    var context = { oids: [] };
+
+    return Repository.open(repoPath)
+      .then(function(repository) {
+        context.repository = repository;
+        return repository.getBranchCommit("master");
+      })
+      .then(function(commit) {
+        return commit.getTree();
+      })
+      .then(function(tree) {
+        return new Promise(function(resolve, reject) {
+          var walker = tree.walk(true);
+
+          walker.on("entry", function(entry) {
+            context.oids.push(entry.sha());
+          });
+          walker.on("error", reject);
+          walker.on("end", function() {
+            resolve(context);
+          });
+          walker.start();
+        });
+      });
+  },
+
+  run: function(context) {
+    var repository = context.repository;
+
+    return Promise.all(context.oids.map(function(oid) {
+      return repository.getBlob(oid).then(function(blob) {
+        return blob.rawsize();
+      });
+    })).then(function(sizes) {
+      return sizes.length;
+    });
+  }
+};
@@ -0,0 +1,32 @@
+var promisify = require("promisify-node");
+var fse = promisify(require("fs-extra"));
+var path = require("path");
+var NodeGit = require("../../");
+var Clone = NodeGit.Clone;
+
+// A bare clone of the whole history over the local transport.
+module.exports = {
+  fixture: "history",
+
+  setup: function(repoPath) {
+    return {
+      url: repoPath,
+      clonePath: path.join(path.dirname(repoPath), "clone")
+    };
+  },
+
+  run: function(context) {
+    return fse.remove(context.clonePath)
+      .then(function() {
+        return Clone.clone(context.url, context.clonePath, { bare: 1 });
+      })
+      .then(function(repository) {
+        repository.free();
+        return 1;
+      });
+  },
+
+  teardown: function(context) {
+    return fse.remove(context.clonePath);
+  }
+};
@@ -0,0 +1,51 @@
+var NodeGit = require("../../");
+var Diff = NodeGit.Diff;
+var Repository = NodeGit.Repository;
+
+// Diffs the tip of the history against a commit a thousand commits back,
+// then turns every delta into a patch.
+module.exports = {
+  fixture: "history",
+
+  setup: function(repoPath) {
+    var context = {};
+
+    return Repository.open(repoPath)
+      .then(function(repository) {
+        context.repository = repository;
+        return repository.getBranchCommit("master");
+      })
+      .then(function(head) {
+        var walker = context.repository.createRevWalk();
+
+        walker.push(head.id());
+        walker.sorting(NodeGit.Revwalk.SORT.TOPOLOGICAL);
+
+        return head.getTree().then(function(tree) {
+          context.newTree = tree;
+          return walker.getCommits(1000);
+        });
+      })
+      .then(function(commits) {
+        return commits[commits.length - 1].getTree();
+      })
+      .then(function(tree) {
+        context.oldTree = tree;
+        return context;
+      });
+  },
+
+  run: function(context) {
+    return Diff.treeToTree(context.repository, context.oldTree,
+      context.newTree, null)
+      .then(function(diff) {
+        var count = 0;
+
+        diff.patches().forEach(function(patch) {
+          count += patch.hunks().length;
+        });
+
+        return count;
+      });
+  }
+};
@@ -0,0 +1,37 @@
+var promisify = require("promisify-node");
+var fse = promisify(require("fs-extra"));
+var path = require("path");
+var NodeGit = require("../../");
+var Remote = NodeGit.Remote;
+var Repository = NodeGit.Repository;
+
+// Fetches the whole history into an empty repository over the local
+// transport.
+module.exports = {
+  fixture: "history",
+
+  setup: function(repoPath) {
+    return {
+      url: repoPath,
+      fetchPath: path.join(path.dirname(repoPath), "fetch")
+    };
+  },
+
+  run: function(context) {
+    return fse.remove(context.fetchPath)
+      .then(function() {
+        return Repository.init(context.fetchPath, 1);
+      })
+      .then(function(repository) {
+        Remote.create(repository, "origin", context.url);
+        return repository.fetch("origin", {});
+      })
+      .then(function() {
+        return 1;
+      });
+  },
+
+  teardown: function(context) {
+    return fse.remove(context.fetchPath);
+  }
+};
@@ -0,0 +1,24 @@
+var NodeGit = require("../../");
+var Repository = NodeGit.Repository;
+
+// Stages every modified and untracked file. The index is read back from
+// disk before each run and never written, so every run starts over.
+module.exports = {
+  fixture: "untracked",
+
+  setup: function(repoPath) {
+    return Repository.open(repoPath).then(function(repository) {
+      return repository.openIndex();
+    }).then(function(index) {
+      return { index: index };
+    });
+  },
+
+  run: function(context) {
+    context.index.read(1);
+
+    return context.index.addAll().then(function() {
+      return context.index.entryCount();
+    });
+  }
+};
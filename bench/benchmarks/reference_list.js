@@ -0,0 +1,21 @@
+var NodeGit = require("../../");
+var Reference = NodeGit.Reference;
+var Repository = NodeGit.Repository;
+
+// Looks up thousands of branches and tags by name.
+module.exports = {
+  fixture: "refs",
+
+  setup: function(repoPath) {
+    return Repository.open(repoPath).then(function(repository) {
+      return { repository: repository };
+    });
+  },
+
+  run: function(context) {
+    return context.repository.getReferenceNames(Reference.TYPE.OID)
+      .then(function(names) {
+        return names.length;
+      });
+  }
+};
@@ -0,0 +1,39 @@
+var NodeGit = require("../../");
+var Repository = NodeGit.Repository;
+
+// Walks the whole history one `next()` and one `getCommit()` at a time, the
+// way Revwalk.prototype.walk does.
+module.exports = {
+  fixture: "history",
+
+  setup: function(repoPath) {
+    return Repository.open(repoPath).then(function(repository) {
+      return repository.getBranchCommit("master").then(function(commit) {
+        return { repository: repository, head: commit.id() };
+      });
+    });
+  },
+
+  run: function(context) {
+    var walker = context.repository.createRevWalk();
+    var count = 0;
+
+    walker.sorting(NodeGit.Revwalk.SORT.TOPOLOGICAL);
+    walker.push(context.head);
+
+    function next() {
+      return walker.next().then(function(oid) {
+        if (!oid) {
+          return count;
+        }
+
+        return context.repository.getCommit(oid).then(function() {
+          count++;
+          return next();
+        });
+      });
+    }
+
+    return next();
+  }
+};
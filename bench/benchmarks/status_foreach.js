@@ -0,0 +1,24 @@
+var NodeGit = require("../../");
+var Repository = NodeGit.Repository;
+var Status = NodeGit.Status;
+
+// A working directory with modified and untracked files.
+module.exports = {
+  fixture: "untracked",
+
+  setup: function(repoPath) {
+    return Repository.open(repoPath).then(function(repository) {
+      return { repository: repository };
+    });
+  },
+
+  run: function(context) {
+    var count = 0;
+
+    return Status.foreach(context.repository, function() {
+      count++;
+    }).then(function() {
+      return count;
+    });
+  }
+};
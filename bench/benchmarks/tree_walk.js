@@ -0,0 +1,34 @@
+var Promise = require("nodegit-promise");
+var NodeGit = require("../../");
+var Repository = NodeGit.Repository;
+
+// Every blob of a tree with thousands of files in hundreds of directories.
+module.exports = {
+  fixture: "wide",
+
+  setup: function(repoPath) {
+    return Repository.open(repoPath).then(function(repository) {
+      return repository.getBranchCommit("master");
+    }).then(function(commit) {
+      return { commit: commit };
+    });
+  },
+
+  run: function(context) {
+    return context.commit.getTree().then(function(tree) {
+      return new Promise(function(resolve, reject) {
+        var count = 0;
+        var walker = tree.walk(true);
+
+        walker.on("entry", function() {
+          count++;
+        });
+        walker.on("error", reject);
+        walker.on("end", function() {
+          resolve(count);
+        });
+        walker.start();
+      });
+    });
+  }
+};
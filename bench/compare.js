@@ -0,0 +1,74 @@
+var fs = require("fs");
+
+/**
+ * Compares the medians of two `npm run bench` results and exits non-zero
+ * when any benchmark got slower by more than the threshold.
+ *
+ *   node bench/compare base.json head.json [--threshold percent]
+ */
+function load(file) {
+  var results = {};
+
+  JSON.parse(fs.readFileSync(file, "utf8")).results.forEach(function(result) {
+    results[result.name] = result;
+  });
+
+  return results;
+}
+
+function pad(text, width) {
+  text = String(text);
+
+  while (text.length < width) {
+    text += " ";
+  }
+
+  return text;
+}
+
+var args = process.argv.slice(2);
+var thresholdIndex = args.indexOf("--threshold");
+var threshold = 10;
+
+if (thresholdIndex !== -1) {
+  threshold = Number(args[thresholdIndex + 1]);
+  args.splice(thresholdIndex, 2);
+}
+
+if (args.length !== 2) {
+  process.stderr.write(
+    "Usage: node bench/compare base.json head.json [--threshold percent]\n");
+  process.exit(2);
+}
+
+var base = load(args[0]);
+var head = load(args[1]);
+var regressed = false;
+
+Object.keys(head).sort().forEach(function(name) {
+  var after = head[name].median;
+
+  if (!base[name]) {
+    process.stdout.write(pad(name, 24) + pad(after.toFixed(2) + "ms", 14) +
+      "new\n");
+    return;
+  }
+
+  var before = base[name].median;
+  var change = (after - before) / before * 100;
+  var flag = "";
+
+  if (change > threshold) {
+    flag = "  slower";
+    regressed = true;
+  }
+  else if (change < -threshold) {
+    flag = "  faster";
+  }
+
+  process.stdout.write(pad(name, 24) + pad(before.toFixed(2) + "ms", 14) +
+    pad(after.toFixed(2) + "ms", 14) + (change >= 0 ? "+" : "") +
+    change.toFixed(1) + "%" + flag + "\n");
+});
+
+process.exit(regressed ? 1 : 0);
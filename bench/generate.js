@@ -0,0 +1,346 @@
+var Promise = require("nodegit-promise");
+var promisify = require("promisify-node");
+var fse = promisify(require("fs-extra"));
+var fs = require("fs");
+var path = require("path");
+var spawn = require("child_process").spawn;
+var local = path.join.bind(path, __dirname);
+
+var exec = promisify(function(command, opts, callback) {
+  return require("child_process").exec(command, opts, callback);
+});
+
+// Bump this whenever a fixture changes shape, so stale copies are rebuilt.
+var VERSION = 1;
+
+// Every fixture is the same for the same seed, down to the commit ids.
+var EPOCH = 1420070400;
+
+/**
+ * A Park-Miller generator. Small enough to keep fixtures reproducible
+ * without depending on Math.random or a library.
+ *
+ * @param {Number} seed
+ */
+function Random(seed) {
+  this.state = seed % 2147483647 || 1;
+}
+
+Random.prototype.next = function() {
+  this.state = (this.state * 16807) % 2147483647;
+  return this.state;
+};
+
+Random.prototype.below = function(max) {
+  return this.next() % max;
+};
+
+Random.prototype.text = function(lines) {
+  var result = [];
+
+  for (var i = 0; i < lines; i++) {
+    result.push("line " + this.next().toString(36) + " " +
+      this.next().toString(36));
+  }
+
+  return result.join("\n") + "\n";
+};
+
+/**
+ * Writes a `git fast-import` stream into a new repository.
+ *
+ * @param {String} repoPath
+ * @param {Boolean} bare
+ */
+function FastImport(repoPath, bare) {
+  this.repoPath = repoPath;
+  this.bare = bare;
+  this.chunks = [];
+  this.mark = 0;
+  this.time = EPOCH;
+}
+
+FastImport.prototype.nextMark = function() {
+  return ++this.mark;
+};
+
+FastImport.prototype.write = function(chunk) {
+  this.chunks.push(typeof chunk === "string" ? new Buffer(chunk) : chunk);
+};
+
+FastImport.prototype.blob = function(content) {
+  var mark = this.nextMark();
+  var data = typeof content === "string" ? new Buffer(content) : content;
+
+  this.write("blob\nmark :" + mark + "\ndata " + data.length + "\n");
+  this.write(data);
+  this.write("\n");
+
+  return mark;
+};
+
+/**
+ * @param {String} ref
+ * @param {Object} commit `files` maps paths to blob marks, `from` and
+ *                        `merge` are commit marks
+ * @return {Number} the commit's mark
+ */
+FastImport.prototype.commit = function(ref, commit) {
+  var mark = this.nextMark();
+  var message = commit.message || "commit " + mark;
+  var who = "Bench <bench@nodegit.org> " + (this.time += 60) + " +0000";
+
+  this.write("commit " + ref + "\nmark :" + mark + "\n");
+  this.write("author " + who + "\ncommitter " + who + "\n");
+  this.write("data " + Buffer.byteLength(message) + "\n" + message + "\n");
+
+  if (commit.from) {
+    this.write("from :" + commit.from + "\n");
+  }
+  if (commit.merge) {
+    this.write("merge :" + commit.merge + "\n");
+  }
+
+  Object.keys(commit.files || {}).forEach(function(file) {
+    this.write("M 100644 :" + commit.files[file] + " " + file + "\n");
+  }, this);
+
+  this.write("\n");
+
+  return mark;
+};
+
+FastImport.prototype.reset = function(ref, mark) {
+  this.write("reset " + ref + "\nfrom :" + mark + "\n\n");
+};
+
+FastImport.prototype.run = function() {
+  var fastImport = this;
+  var init = "git init " + (fastImport.bare ? "--bare " : "") +
+    JSON.stringify(fastImport.repoPath);
+
+  return exec(init).then(function() {
+    return new Promise(function(resolve, reject) {
+      var child = spawn("git", ["fast-import", "--quiet"], {
+        cwd: fastImport.repoPath,
+        stdio: ["pipe", "ignore", "inherit"]
+      });
+
+      child.on("error", reject);
+      child.on("exit", function(code) {
+        if (code) {
+          return reject(new Error("git fast-import exited with " + code));
+        }
+        resolve();
+      });
+
+      fastImport.chunks.forEach(function(chunk) {
+        child.stdin.write(chunk);
+      });
+      fastImport.chunks = [];
+      child.stdin.end();
+    });
+  });
+};
+
+/**
+ * The fixtures, keyed by name. Each one writes a repository to `repoPath`,
+ * sized by `scale`.
+ */
+var fixtures = {
+  // A long history touching a few files per commit, with a merge every
+  // hundred commits.
+  history: function(repoPath, scale, random) {
+    var fastImport = new FastImport(repoPath, true);
+    var commits = 5000 * scale;
+    var files = {};
+    var head = null;
+
+    for (var i = 0; i < 200; i++) {
+      files["dir" + (i % 20) + "/file" + i + ".txt"] =
+        fastImport.blob(random.text(20));
+    }
+
+    for (i = 0; i < commits; i++) {
+      var changed = {};
+      var count = 1 + random.below(3);
+
+      for (var j = 0; j < count; j++) {
+        var file = "dir" + random.below(20) + "/file" + random.below(200) +
+          ".txt";
+        changed[file] = files[file] = fastImport.blob(random.text(20));
+      }
+
+      if (i % 100 === 99) {
+        var side = fastImport.commit("refs/heads/side", {
+          from: head,
+          files: changed
+        });
+
+        head = fastImport.commit("refs/heads/master", {
+          from: head,
+          merge: side,
+          files: changed,
+          message: "merge " + i
+        });
+      }
+      else {
+        head = fastImport.commit("refs/heads/master", {
+          from: head,
+          files: i === 0 ? files : changed
+        });
+      }
+    }
+
+    return fastImport.run();
+  },
+
+  // One commit with a few levels of directories and lots of small files.
+  wide: function(repoPath, scale, random) {
+    var fastImport = new FastImport(repoPath, true);
+    var files = {};
+
+    for (var i = 0; i < 20; i++) {
+      for (var j = 0; j < 20 * scale; j++) {
+        for (var k = 0; k < 25; k++) {
+          files["top" + i + "/sub" + j + "/file" + k + ".txt"] =
+            fastImport.blob(random.text(5));
+        }
+      }
+    }
+
+    fastImport.commit("refs/heads/master", { files: files });
+
+    return fastImport.run();
+  },
+
+  // A single big file, changed in the middle by its second commit.
+  huge: function(repoPath, scale, random) {
+    var fastImport = new FastImport(repoPath, true);
+    // 32MB at scale 1, in whole 32 bit words.
+    var size = 4 * Math.ceil(8 * 1024 * 1024 * scale);
+    var content = new Buffer(size);
+
+    for (var i = 0; i < size; i += 4) {
+      content.writeUInt32LE(random.next() >>> 0, i);
+    }
+
+    var first = fastImport.commit("refs/heads/master", {
+      files: { "huge.bin": fastImport.blob(content) }
+    });
+
+    content.write("changed", Math.floor(size / 2));
+    fastImport.commit("refs/heads/master", {
+      from: first,
+      files: { "huge.bin": fastImport.blob(content) }
+    });
+
+    return fastImport.run();
+  },
+
+  // A short history with a branch and a tag on nearly every commit.
+  refs: function(repoPath, scale, random) {
+    var fastImport = new FastImport(repoPath, true);
+    var marks = [];
+    var head = null;
+
+    for (var i = 0; i < 200; i++) {
+      head = fastImport.commit("refs/heads/master", {
+        from: head,
+        files: { "file.txt": fastImport.blob(random.text(5)) }
+      });
+      marks.push(head);
+    }
+
+    for (i = 0; i < 2500 * scale; i++) {
+      fastImport.reset("refs/heads/branch" + i, marks[random.below(200)]);
+      fastImport.reset("refs/tags/tag" + i, marks[random.below(200)]);
+    }
+
+    return fastImport.run();
+  },
+
+  // A checked out working directory, a third of it modified, plus a pile of
+  // untracked files.
+  untracked: function(repoPath, scale, random) {
+    var fastImport = new FastImport(repoPath, false);
+    var files = {};
+    var paths = [];
+
+    for (var i = 0; i < 3000 * scale; i++) {
+      var file = "dir" + (i % 30) + "/file" + i + ".txt";
+
+      files[file] = fastImport.blob(random.text(5));
+      paths.push(file);
+    }
+
+    fastImport.commit("refs/heads/master", { files: files });
+
+    return fastImport.run()
+      .then(function() {
+        return exec("git checkout -f master", { cwd: repoPath });
+      })
+      .then(function() {
+        paths.forEach(function(file, index) {
+          if (index % 3 === 0) {
+            fs.appendFileSync(path.join(repoPath, file), "modified\n");
+          }
+        });
+
+        for (var i = 0; i < 50; i++) {
+          fs.mkdirSync(path.join(repoPath, "untracked" + i));
+        }
+
+        for (i = 0; i < 5000 * scale; i++) {
+          fs.writeFileSync(
+            path.join(repoPath, "untracked" + (i % 50), "new" + i + ".txt"),
+            random.text(3));
+        }
+      });
+  }
+};
+
+/**
+ * Builds the named fixture unless an up to date copy is already there.
+ *
+ * @param {String} name
+ * @param {Number} scale
+ * @return {String} the repository's path
+ */
+function generate(name, scale) {
+  var repoPath = local("repos", name + "-" + scale);
+  // Kept next to the repository so it never shows up in a status.
+  var stampPath = repoPath + ".json";
+  var stamp = JSON.stringify({ version: VERSION, name: name, scale: scale });
+
+  return fse.readFile(stampPath, "utf8")
+    .then(function(existing) {
+      return existing === stamp;
+    }, function() {
+      return false;
+    })
+    .then(function(upToDate) {
+      if (upToDate) {
+        return repoPath;
+      }
+
+      process.stderr.write("generating " + name + " fixture\n");
+
+      return fse.remove(repoPath)
+        .then(function() {
+          return fse.mkdirs(repoPath);
+        })
+        .then(function() {
+          return fixtures[name](repoPath, scale, new Random(VERSION));
+        })
+        .then(function() {
+          return fse.writeFile(stampPath, stamp);
+        })
+        .then(function() {
+          return repoPath;
+        });
+    });
+}
+
+module.exports = generate;
+module.exports.fixtures = Object.keys(fixtures);
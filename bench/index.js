@@ -0,0 +1,204 @@
+var Promise = require("nodegit-promise");
+var promisify = require("promisify-node");
+var fse = promisify(require("fs-extra"));
+var fs = require("fs");
+var os = require("os");
+var path = require("path");
+var generate = require("./generate");
+var local = path.join.bind(path, __dirname);
+
+var exec = promisify(function(command, opts, callback) {
+  return require("child_process").exec(command, opts, callback);
+});
+
+/**
+ * Runs the benchmarks in `bench/benchmarks` against generated repositories
+ * and prints the results as JSON. See `bench/compare.js` for comparing two
+ * runs.
+ *
+ *   npm run bench -- [--filter name] [--iterations n] [--scale n]
+ *                    [--out results.json]
+ */
+function parseArgs(argv) {
+  var options = {
+    filter: null,
+    iterations: 5,
+    scale: Number(process.env.NODEGIT_BENCH_SCALE) || 1,
+    out: null
+  };
+
+  for (var i = 0; i < argv.length; i++) {
+    switch (argv[i]) {
+      case "--filter":
+        options.filter = argv[++i];
+        break;
+      case "--iterations":
+        options.iterations = Number(argv[++i]);
+        break;
+      case "--scale":
+        options.scale = Number(argv[++i]);
+        break;
+      case "--out":
+        options.out = argv[++i];
+        break;
+      default:
+        throw new Error("Unknown argument " + argv[i]);
+    }
+  }
+
+  return options;
+}
+
+function milliseconds(start) {
+  var elapsed = process.hrtime(start);
+  return elapsed[0] * 1e3 + elapsed[1] / 1e6;
+}
+
+function summarize(times) {
+  var sorted = times.slice().sort(function(a, b) {
+    return a - b;
+  });
+  var middle = Math.floor(sorted.length / 2);
+  var total = sorted.reduce(function(sum, time) {
+    return sum + time;
+  }, 0);
+
+  return {
+    min: sorted[0],
+    median: sorted.length % 2 ?
+      sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2,
+    mean: total / sorted.length,
+    max: sorted[sorted.length - 1]
+  };
+}
+
+// Collecting garbage between runs keeps one run's garbage from being
+// charged to the next, when node was started with --expose-gc.
+function collect() {
+  if (global.gc) {
+    global.gc();
+  }
+}
+
+function runBenchmark(name, benchmark, options) {
+  var times = [];
+  var ops = 0;
+  var context;
+
+  function iterate(remaining) {
+    if (!remaining) {
+      return Promise.resolve();
+    }
+
+    collect();
+    var start = process.hrtime();
+
+    return Promise.resolve(benchmark.run(context)).then(function(count) {
+      times.push(milliseconds(start));
+      ops = count;
+      return iterate(remaining - 1);
+    });
+  }
+
+  return generate(benchmark.fixture, options.scale)
+    .then(function(repoPath) {
+      return benchmark.setup(repoPath);
+    })
+    .then(function(result) {
+      context = result;
+      process.stderr.write(name + ": ");
+
+      // One run to warm the caches, which isn't counted.
+      return benchmark.run(context);
+    })
+    .then(function() {
+      return iterate(options.iterations);
+    })
+    .then(function() {
+      return benchmark.teardown && benchmark.teardown(context);
+    })
+    .then(function() {
+      var result = summarize(times);
+
+      result.name = name;
+      result.fixture = benchmark.fixture;
+      result.ops = ops;
+      result.opsPerSecond = result.median ? ops / result.median * 1e3 : 0;
+      result.times = times;
+
+      process.stderr.write(result.median.toFixed(2) + "ms median, " +
+        ops + " ops\n");
+
+      return result;
+    });
+}
+
+function describeEnvironment(options) {
+  var environment = {
+    date: new Date().toISOString(),
+    node: process.version,
+    nodegit: require("../package").version,
+    libgit2: require("../package").libgit2.version,
+    platform: process.platform,
+    arch: process.arch,
+    cpus: os.cpus().length,
+    scale: options.scale,
+    iterations: options.iterations,
+    commit: null
+  };
+
+  return exec("git rev-parse HEAD", { cwd: local("..") })
+    .then(function(stdout) {
+      environment.commit = String(stdout).trim();
+    }, function() {
+      // Not a checkout, so there's no commit to report.
+    })
+    .then(function() {
+      return environment;
+    });
+}
+
+function main(options) {
+  var names = fs.readdirSync(local("benchmarks"))
+    .filter(function(file) {
+      return path.extname(file) === ".js";
+    })
+    .map(function(file) {
+      return path.basename(file, ".js");
+    })
+    .filter(function(name) {
+      return !options.filter || name.indexOf(options.filter) !== -1;
+    })
+    .sort();
+
+  var output = { results: [] };
+
+  return describeEnvironment(options)
+    .then(function(environment) {
+      output.environment = environment;
+
+      return names.reduce(function(previous, name) {
+        return previous.then(function() {
+          var benchmark = require("./benchmarks/" + name);
+
+          return runBenchmark(name, benchmark, options).then(function(result) {
+            output.results.push(result);
+          });
+        });
+      }, Promise.resolve());
+    })
+    .then(function() {
+      var json = JSON.stringify(output, null, 2) + "\n";
+
+      if (options.out) {
+        return fse.writeFile(options.out, json);
+      }
+
+      process.stdout.write(json);
+    });
+}
+
+main(parseArgs(process.argv.slice(2))).done(null, function(error) {
+  process.stderr.write((error.stack || error) + "\n");
+  process.exit(1);
+});
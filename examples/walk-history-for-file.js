@@ -1,55 +1,38 @@
 var nodegit = require("../"),
     path = require("path");
 
-// This code walks the history of the master branch and prints results
-// that look very similar to calling `git log` from the command line
+// This code walks the history of the master branch and prints the commits
+// that changed a file, like calling `git log --follow -- <file>` from the
+// command line would
 
 nodegit.Repository.open(path.resolve(__dirname, "../.git"))
   .then(function(repo) {
     return repo.getMasterCommit();
   })
-  .then(function(firstCommitOnMaster){
-    // History returns an event.
-    var history = firstCommitOnMaster.history(nodegit.Revwalk.SORT.Time);
-    var commits = [];
-
-    // History emits "commit" event for each commit in the branch's history
-    history.on("commit", function(commit) {
-      return commit.getDiff()
-      .then(function(diffList) {
-        var addCommit = diffList.reduce(function(prevVal, diff) {
-          var result =
-            prevVal ||
-            diff.patches().reduce(function(prevValDiff, patch) {
-
-            var result =
-              prevValDiff ||
-              !!~patch.oldFile().path().indexOf("descriptor.json") ||
-              !!~patch.newFile().path().indexOf("descriptor.json");
-
-            return result;
-          }, false);
+  .then(function(firstCommitOnMaster) {
+    // The trees are compared natively, so no Diff or Commit is made for the
+    // commits that don't touch the file.
+    var history = firstCommitOnMaster.historyStream({
+      sorting: [nodegit.Revwalk.SORT.TIME],
+      path: "generate/input/descriptor.json",
+      followRenames: true
+    });
 
-          return result;
-        }, false);
+    // Every chunk holds a batch of commits as parallel arrays.
+    history.on("data", function(chunk) {
+      var shas = nodegit.Oid.toStrings(chunk.ids);
 
-        if (addCommit) {
-          commits.push(commit);
-        }
+      shas.forEach(function(sha, i) {
+        console.log("commit " + sha);
+        console.log("Author:", chunk.authorNames[i] +
+          " <" + chunk.authorEmails[i] + ">");
+        console.log("Date:", new Date(chunk.authorTimes[i] * 1000));
+        console.log("\n    " + chunk.summaries[i] + "\n");
       });
     });
 
-    history.on("end", function() {
-      commits.forEach(function(commit) {
-        console.log("commit " + commit.sha());
-        console.log("Author:", commit.author().name() +
-          " <" + commit.author().email() + ">");
-        console.log("Date:", commit.date());
-        console.log("\n    " + commit.message());
-      });
+    history.on("error", function(error) {
+      console.error(error);
     });
-
-    // Don't forget to call `start()`!
-    history.start();
   })
   .done();
@@ -179,6 +179,60 @@ module.exports = function generateJson() {
 
     def.functions.forEach(function(fn) {
       fn.cppClassName = def.cppClassName;
+      fn.jsClassName = def.jsClassName;
+    });
+  });
+
+  // Class types with readable fields get a native toObject. Fields of those
+  // types reuse it instead of allocating a wrapper.
+  var plainObjectTypes = {};
+
+  output.forEach(function(def) {
+    def.hasToObject = !def.ignore && def.type == "class" && !!def.cType &&
+      def.fields.some(function(field) {
+        return !field.ignore;
+      });
+
+    if (def.hasToObject) {
+      plainObjectTypes[def.cType] = true;
+    }
+  });
+
+  output.forEach(function(def) {
+    def.fields.forEach(function(field) {
+      field.hasToObject = !!plainObjectTypes[helpers.normalizeCtype(field.cType)];
+    });
+  });
+
+  // Wrapped classes can be disposed of through a Scope. Calls pass their
+  // scope on from `this` or from wrapped arguments, and what libgit2 hands
+  // over through a non-const out parameter is the caller's to free.
+  var scopedTypes = {};
+
+  output.forEach(function(def) {
+    if (!def.ignore && def.type == "class" && def.cType &&
+        def.cType != "git_oid") {
+      scopedTypes[def.cType] = def.cppClassName;
+    }
+  });
+
+  output.forEach(function(def) {
+    def.functions.forEach(function(fn) {
+      (fn.args || []).forEach(function(arg) {
+        var cppClassName = scopedTypes[helpers.normalizeCtype(arg.cType)];
+
+        if (!cppClassName || arg.cppClassName != cppClassName) {
+          return;
+        }
+
+        if (arg.isReturn) {
+          arg.isOwned = utils.isDoublePointer(arg.cType) &&
+            !/^const\b/.test(arg.cType);
+        }
+        else if (!arg.isSelf && !arg.payloadFor) {
+          arg.joinsScope = true;
+        }
+      });
     });
   });
 
@@ -29,12 +29,14 @@ module.exports = function generateNativeCode() {
   var partials = {
     asyncFunction: utils.readFile("templates/partials/async_function.cc"),
     callbackHelpers: utils.readFile("templates/partials/callback_helpers.cc"),
+    callScope: utils.readFile("templates/partials/call_scope.cc"),
     convertFromV8: utils.readFile("templates/partials/convert_from_v8.cc"),
     convertToV8: utils.readFile("templates/partials/convert_to_v8.cc"),
     doc: utils.readFile("templates/partials/doc.cc"),
     fields: utils.readFile("templates/partials/fields.cc"),
     guardArguments: utils.readFile("templates/partials/guard_arguments.cc"),
     syncFunction: utils.readFile("templates/partials/sync_function.cc"),
+    toObject: utils.readFile("templates/partials/to_object.cc"),
     fieldAccessors: utils.readFile("templates/partials/field_accessors.cc")
   };
 
@@ -98,6 +100,16 @@ module.exports = function generateNativeCode() {
     return !idef.ignore;
   });
 
+  // Pull in the bodies of hand written functions so the class templates can
+  // emit them in place of a generated one.
+  enabled.forEach(function(idef) {
+    (idef.functions || []).forEach(function(fn) {
+      if (fn.isManual) {
+        fn.implementation = utils.readFile(fn.cFile);
+      }
+    });
+  });
+
 
   fse.remove(path.resolve(__dirname, "../../src")).then(function() {
     return fse.remove(path.resolve(__dirname, "../../include"));
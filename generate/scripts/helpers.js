@@ -110,6 +110,14 @@ var Helpers = {
 
     if (callbackDefs[field.type]) {
       _.merge(field, callbackDefs[field.type]);
+
+      // Callbacks that hand values back through out params have to answer
+      // libgit2 synchronously, so they can never be batched.
+      if (field.batch && field.args.some(function(arg) {
+        return arg.isReturn;
+      })) {
+        delete field.batch;
+      }
     }
     else {
       if (process.env.BUILD_ONLY) {
@@ -186,18 +194,40 @@ var Helpers = {
     var normalizedType = Helpers.normalizeCtype(typeDef.cType);
     typeDef.hasConstructor = Helpers.hasConstructor(typeDef, normalizedType);
 
+    var typeDefOverrides = descriptor.types[typeDef.typeName] || {};
+    var functionOverrides = typeDefOverrides.functions || {};
+
+    // Hand written functions (see templates/manual_functions) can add methods
+    // that have no libgit2 counterpart, so they only exist in the descriptor.
+    _.forEach(functionOverrides, function(fnOverrides, fnName) {
+      if (fnOverrides.isManual && !~typeDef.functions.indexOf(fnName)) {
+        typeDef.functions.push(fnName);
+      }
+    });
+
     typeDef.functions = (typeDef.functions).map(function(fn) {
-      var fnDef = libgit2.functions[fn];
+      var fnDef = libgit2.functions[fn] || { args: [] };
       fnDef.cFunctionName = fn;
       return fnDef;
     });
 
-    var typeDefOverrides = descriptor.types[typeDef.typeName] || {};
-    var functionOverrides = typeDefOverrides.functions || {};
     typeDef.functions.forEach(function(fnDef) {
       Helpers.decorateFunction(fnDef, typeDef, functionOverrides[fnDef.cFunctionName] || {}, enums);
     });
 
+    // An async function can also be bound as a blocking `...Sync` method.
+    typeDef.functions.filter(function(fnDef) {
+      return fnDef.isAsync && fnDef.hasSyncVariant;
+    }).forEach(function(fnDef) {
+      var syncDef = _.cloneDeep(fnDef);
+
+      syncDef.isAsync = false;
+      syncDef.hasSyncVariant = false;
+      syncDef.cppFunctionName += "Sync";
+      syncDef.jsFunctionName += "Sync";
+      typeDef.functions.push(syncDef);
+    });
+
     _.merge(typeDef, partialOverrides);
   },
 
@@ -327,9 +357,56 @@ var Helpers = {
     if ("git_" + typeDef.typeName == fnDef.cFunctionName) {
       fnDef.useAsOnRootProto = true;
     }
+
+    // isAsync can still come from the overrides below, so decorate everything
+    Helpers.decorateRepoAccess(fnDef, typeDef, fnOverrides);
+
     _.merge(fnDef, _.omit(fnOverrides, "args", "return"));
   },
 
+  // Works out which repository an async call touches, either straight from a
+  // `git_repository *` argument or through the owner accessor of `this`, so
+  // the thread pool can order calls on the same repository. Objects that have
+  // no repository, like a config, are ordered on themselves when the
+  // descriptor gives the function a `"repoAccess"`.
+  //
+  // Calls run as readers, side by side, unless the descriptor tags them
+  // `"repoAccess": "write"`. Anything that modifies the repository or the
+  // object it is called on (reading an index, stepping a walk or an
+  // iterator) has to be tagged there.
+  decorateRepoAccess: function(fnDef, typeDef, fnOverrides) {
+    var ownerFunction = [typeDef.cType + "_owner", typeDef.cType + "_repository"]
+      .filter(function(name) {
+        return libgit2.functions[name];
+      })[0];
+
+    fnDef.args.some(function(arg) {
+      if (!arg.isReturn && !arg.payloadFor
+          && Helpers.normalizeCtype(arg.cType) == "git_repository") {
+        fnDef.repoKey = { name: arg.name };
+      }
+      else if (arg.isSelf && ownerFunction) {
+        fnDef.repoKey = { name: arg.name, ownerFunction: ownerFunction };
+      }
+
+      return fnDef.repoKey;
+    });
+
+    if (!fnDef.repoKey && fnOverrides.repoAccess) {
+      fnDef.args.some(function(arg) {
+        if (arg.isSelf) {
+          fnDef.repoKey = { name: arg.name };
+        }
+
+        return fnDef.repoKey;
+      });
+    }
+
+    if (fnDef.repoKey) {
+      fnDef.repoAccess = fnOverrides.repoAccess || "read";
+    }
+  },
+
   filterIgnored: function (arr, callback) {
     if (!arr) {
       return;
@@ -0,0 +1,39 @@
+#ifndef ARGUMENT_ARENA_H
+#define ARGUMENT_ARENA_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+/**
+ * Scratch memory for the C values a binding builds from its JS arguments.
+ *
+ * Small allocations are carved out of storage inside the arena itself, larger
+ * ones fall back to malloc. Everything is released at once, at the end of a
+ * sync call or when the baton of an async one is released, so the generated
+ * code never frees arguments one by one.
+ */
+class ArgumentArena {
+  public:
+    ArgumentArena();
+    ~ArgumentArena();
+
+    void *Alloc(size_t size);
+    char *Strdup(const char *str);
+
+    // Drops everything so a pooled baton can reuse the arena.
+    void Reset();
+
+  private:
+    // Fits a couple of paths or a dozen oids.
+    static const size_t INLINE_SIZE = 256;
+
+    uint64_t storage[INLINE_SIZE / sizeof(uint64_t)];
+    size_t used;
+    std::vector<void *> spilled;
+
+    ArgumentArena(const ArgumentArena &);
+    ArgumentArena &operator=(const ArgumentArena &);
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef CALLBACK_BATCH_H
+#define CALLBACK_BATCH_H
+
+#include <vector>
+#include <uv.h>
+
+#include "nan.h"
+#include "callback_dispatcher.h"
+
+using namespace v8;
+
+/**
+ * Buffers invocations of a high-frequency libgit2 callback on the worker
+ * thread so they can be handed to JS as a single array.
+ *
+ * In the default mode the worker flushes, and waits for JS, once `size`
+ * entries are buffered or the oldest entry is `wait` microseconds old. The
+ * value JS returns for a batch is handed back to libgit2 on the following
+ * invocation, so a non-zero result still stops the iteration.
+ *
+ * In coalescing mode (used for progress snapshots) only the newest entry is
+ * kept and the worker never waits; JS receives it whenever the loop is free.
+ * The thread pool still waits for it once the job is done, so the last
+ * snapshot is never delivered after the job has completed.
+ *
+ * A delivery can still be queued when the owner lets go of the batch, so
+ * owners call Dispose instead of deleting it. The batch is deleted once no
+ * delivery holds it, and one that runs after Dispose only releases its
+ * entries, as the callback is gone by then.
+ */
+class CallbackBatch {
+  public:
+    typedef void (*Release)(void *entry);
+
+    static void Initialize();
+
+    CallbackBatch(
+      NanCallback *callback,
+      Release release,
+      size_t size,
+      unsigned int wait,
+      bool coalesce
+    );
+
+    // Loop thread, instead of delete.
+    void Dispose();
+
+    // Returns NULL unless the function was tagged with a `batch` object,
+    // see `NodeGit.Utils.batched`.
+    static CallbackBatch *FromFunction(
+      Handle<Function> fn,
+      NanCallback *callback,
+      Release release,
+      size_t defaultSize,
+      unsigned int defaultWait,
+      bool coalesce
+    );
+
+    // Worker thread.
+    int Push(void *entry, CallbackDispatcher::Handler deliver);
+    void Flush(CallbackDispatcher::Handler deliver);
+
+    // Worker thread, once a job is done: waits until JS has been handed
+    // whatever the batches the job pushed to are still holding.
+    static void FlushPushed();
+
+    // Loop thread, used by the generated deliver handlers.
+    std::vector<void *> Take();
+    void Delivered(std::vector<void *> &entries, int result);
+
+    // NULL once the batch has been disposed of.
+    NanCallback *callback;
+
+  private:
+    ~CallbackBatch();
+
+    // Returns whether that was the last reference. Call with mutex held.
+    bool Unreference();
+    void Drain();
+
+    // The batches pushed to by the job on the current thread.
+    static uv_key_t pushed;
+
+    Release release;
+    size_t size;
+    uint64_t wait;
+    bool coalesce;
+
+    std::vector<void *> entries;
+    uint64_t firstQueued;
+    int result;
+    bool pending;
+    // Set while a worker waits for a coalesced entry to be delivered.
+    bool draining;
+    CallbackDispatcher::Handler deliver;
+    // The owner's, one for every delivery queued and one for every job
+    // that has pushed to the batch and not finished yet.
+    unsigned int references;
+
+    uv_mutex_t mutex;
+    uv_sem_t semaphore;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef CALLBACK_DISPATCHER_H
+#define CALLBACK_DISPATCHER_H
+
+#include <queue>
+#include <uv.h>
+
+/**
+ * Hands callback batons from libgit2 worker threads over to the main loop.
+ *
+ * A single long-lived uv_async_t is shared by every callback; workers push
+ * their baton onto a locked queue and block on the baton's own semaphore
+ * until the loop side is done with it.
+ */
+class CallbackDispatcher {
+  public:
+    typedef void (*Handler)(void *baton);
+
+    static void Initialize();
+
+    // Safe to call from any thread.
+    static void Enqueue(Handler handler, void *baton);
+
+    // Worker thread: tags what it enqueues from here on with `origin`, until
+    // it is set back to NULL.
+    static void SetOrigin(const void *origin);
+    // Loop thread: the origin of the handler being run, NULL outside one.
+    static const void *Origin();
+
+  private:
+    struct Job {
+      Handler handler;
+      void *baton;
+      const void *origin;
+    };
+
+    static void Drain(uv_async_t *handle, int status);
+
+    static uv_async_t handle;
+    static uv_mutex_t mutex;
+    static std::queue<Job> jobs;
+    static uv_key_t origins;
+    static const void *running;
+};
+
+#endif
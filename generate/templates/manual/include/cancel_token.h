@@ -0,0 +1,52 @@
+#ifndef CANCEL_TOKEN_H
+#define CANCEL_TOKEN_H
+
+#include <v8.h>
+#include <node.h>
+#include <uv.h>
+
+#include "nan.h"
+
+using namespace node;
+using namespace v8;
+
+/**
+ * `NodeGit.CancelToken`, which can be passed to any async method right
+ * before its callback.
+ *
+ * A job whose token is cancelled before it starts never reaches libgit2.
+ * Once it is running, the thread pool makes its token the current one for
+ * the thread, and the generated callbacks return GIT_EUSER as soon as that
+ * token is cancelled. libgit2 then unwinds the operation. Work that passes
+ * no callback to libgit2 cannot be interrupted halfway.
+ */
+class CancelToken : public ObjectWrap {
+  public:
+    static Persistent<FunctionTemplate> constructor_template;
+    static void InitializeComponent(Handle<v8::Object> target);
+
+    // Returns NULL if the value isn't a CancelToken.
+    static CancelToken *FromValue(Handle<v8::Value> value);
+
+    bool IsCancelled();
+
+    // Worker threads.
+    static void SetCurrent(CancelToken *token);
+    static bool IsCurrentCancelled();
+    static void SetCancelledError();
+
+  private:
+    CancelToken();
+    ~CancelToken();
+
+    static NAN_METHOD(JSNewFunction);
+    static NAN_METHOD(Cancel);
+    static NAN_METHOD(JSIsCancelled);
+
+    bool cancelled;
+    uv_mutex_t mutex;
+
+    static uv_key_t current;
+};
+
+#endif
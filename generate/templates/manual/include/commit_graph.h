@@ -0,0 +1,136 @@
+#ifndef COMMIT_GRAPH_H
+#define COMMIT_GRAPH_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <uv.h>
+
+extern "C" {
+#include <git2.h>
+}
+
+/**
+ * A sidecar file next to the repository, `nodegit-commit-graph` in its git
+ * directory, with every commit reachable from its refs: a sorted oid table,
+ * parent links, generation numbers and commit times. Ahead/behind counts and
+ * merge bases are answered from it without parsing a single commit.
+ *
+ * Commits never change, so a graph that is behind the refs is still right
+ * about everything in it. A query that starts from a commit the graph
+ * doesn't have returns GIT_PASSTHROUGH, and the caller asks libgit2 instead.
+ * Update adds whatever is new since the last update, and the file is
+ * replaced atomically, so it can run while other threads are reading. An
+ * update that finds another one's lock file fails with GIT_ELOCKED.
+ *
+ * Loaded graphs are shared by every thread and kept until the file changes.
+ * The file is mapped where mmap is available and read into memory elsewhere,
+ * which leaves it free to be replaced on Windows.
+ */
+class CommitGraph {
+  public:
+    // Before any thread can query.
+    static void Initialize();
+
+    // The graph for repo, or NULL if there is none (or it is unreadable).
+    // Every graph acquired has to be released again.
+    static CommitGraph *Acquire(git_repository *repo);
+    void Release();
+
+    static int Update(git_repository *repo);
+
+    int AheadBehind(size_t *ahead, size_t *behind,
+      const git_oid *local, const git_oid *upstream) const;
+    int MergeBase(git_oid *out, const git_oid *one, const git_oid *two) const;
+
+    // What AheadBehind, and MergeBase when bases isn't NULL, say about every
+    // tip against base, reusing one set of walk state for all of them. Tips
+    // the graph doesn't have (or every tip, without a graph) are answered by
+    // libgit2. A tip with no merge base gets a zero oid.
+    static int AheadBehindMany(git_repository *repo, const git_oid *base,
+      const git_oid *tips, size_t count, size_t *ahead, size_t *behind,
+      git_oid *bases);
+
+    // On disk, in the byte order of the machine that wrote it.
+    struct Header {
+      char magic[4];
+      uint32_t version;
+      uint32_t byteOrder;
+      uint32_t count;
+      uint32_t extraCount;
+      uint32_t reserved;
+      // How many oids start with a byte up to and including the index.
+      uint32_t fanout[256];
+    };
+
+    struct Commit {
+      uint32_t parents[2];
+      uint32_t generation;
+      uint32_t timeLow;
+      uint32_t timeHigh;
+    };
+
+    // A parent that isn't there, and the flags for a second parent that is
+    // really the start of a list of them, and for the end of that list.
+    static const uint32_t NO_PARENT = 0xffffffff;
+    static const uint32_t EXTRA_PARENTS = 0x80000000;
+
+  private:
+    CommitGraph();
+    ~CommitGraph();
+
+    static std::string PathFor(git_repository *repo);
+    static CommitGraph *Load(const std::string &path);
+
+    struct Painter;
+
+    bool Find(const git_oid *id, uint32_t *position) const;
+    void Parents(uint32_t position, std::vector<uint32_t> *out) const;
+
+    // Walks down from both commits, newest generation first, counting the
+    // commits only one of them reaches unless onlyOne is NULL. With common,
+    // also finds the first commit both reach, which can't be an ancestor of
+    // another one, and says whether there was one.
+    bool Paint(Painter &painter, uint32_t one, uint32_t two, size_t *onlyOne,
+      size_t *onlyTwo, uint32_t *common) const;
+
+    static int HideKnown(const git_oid *id, void *payload);
+    static int Write(git_repository *repo, const CommitGraph *old);
+
+    const Header *header;
+    const git_oid *ids;
+    const Commit *commits;
+    const uint32_t *extraParents;
+
+    void *data;
+    size_t size;
+    bool mapped;
+
+    // Identifies the file the graph was read from.
+    std::string path;
+    uint64_t fileTime;
+    uint64_t fileSize;
+    uint64_t fileId;
+
+    // Guarded by mutex, like the cache of loaded graphs.
+    unsigned int references;
+
+    static uv_mutex_t mutex;
+};
+
+extern "C" {
+  // The same as the libgit2 functions, answered from the commit graph when
+  // it has the commits they start from.
+  int nodegit_graph_ahead_behind(size_t *ahead, size_t *behind,
+    git_repository *repo, const git_oid *local, const git_oid *upstream);
+  int nodegit_merge_base(git_oid *out, git_repository *repo,
+    const git_oid *one, const git_oid *two);
+  int nodegit_graph_ahead_behind_many(size_t *ahead, size_t *behind,
+    git_oid *bases, git_repository *repo, const git_oid *base,
+    const git_oid *tips, size_t count);
+
+  // Builds or brings up to date the repository's commit graph.
+  int nodegit_graph_write_commit_graph(git_repository *repo);
+}
+
+#endif
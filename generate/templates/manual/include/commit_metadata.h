@@ -0,0 +1,60 @@
+#ifndef COMMIT_METADATA_H
+#define COMMIT_METADATA_H
+
+#include <v8.h>
+#include <string>
+#include <vector>
+
+#include "nan.h"
+
+extern "C" {
+#include <git2.h>
+}
+
+using namespace v8;
+
+/**
+ * What a log view shows about a run of commits, copied out of libgit2 on a
+ * worker so the loop thread never has to wrap a commit to read it.
+ *
+ * Read appends a commit; ToColumns turns everything read so far into one
+ * object of parallel arrays, which is far fewer handles than an object per
+ * commit. Commits are found through the repository's object cache, which
+ * libgit2 shares between threads, so only accessors that don't fill in
+ * anything lazily are used.
+ */
+class CommitMetadata {
+  public:
+    // Returns a libgit2 error code; nothing is appended on failure.
+    int Read(git_repository *repo, const git_oid *id);
+
+    size_t Count() const {
+      return entries.size();
+    }
+
+    // On the loop thread, once the worker is done.
+    Handle<Object> ToColumns() const;
+
+  private:
+    struct Person {
+      std::string name;
+      std::string email;
+      git_time_t time;
+      int offset;
+    };
+
+    struct Entry {
+      git_oid id;
+      std::vector<git_oid> parents;
+      Person author;
+      Person committer;
+      std::string summary;
+    };
+
+    static void CopyPerson(Person *to, const git_signature *from);
+    static void CopySummary(std::string *to, const char *message);
+
+    std::vector<Entry> entries;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "nan.h"
+
+extern "C" {
+#include <git2.h>
+}
+
+using namespace v8;
+
+/**
+ * Native memory held by wrappers, reported to V8 so that a few small JS
+ * objects pinning megabytes of trees, diffs or blobs still get collected,
+ * and exposed as `NodeGit.Footprint.get()` to track down what is kept alive.
+ *
+ * Every generated wrapper counts itself under its type while it is alive.
+ * A wrapper that owns its object also charges the object's size, estimated
+ * by `Of`, from when it is made until the object is freed. Only the few
+ * types that can get big have an estimate; for everything else it is 0.
+ *
+ * Wrappers are made and collected on the loop thread, so nothing is locked.
+ */
+class Footprint {
+  public:
+    struct Type {
+      const char *name;
+      uint64_t live;
+      uint64_t created;
+      int64_t bytes;
+    };
+
+    static void InitializeComponent(Handle<v8::Object> target);
+
+    // Called once per wrapper type, from a static initializer.
+    static Type *Register(const char *name);
+
+    static void Created(Type *type) {
+      type->live++;
+      type->created++;
+    }
+
+    static void Destroyed(Type *type) {
+      type->live--;
+    }
+
+    static void Charge(Type *type, int64_t bytes) {
+      if (bytes != 0) {
+        type->bytes += bytes;
+        NanAdjustExternalMemory((int)bytes);
+      }
+    }
+
+    // Best guesses at what libgit2 keeps allocated for an object.
+    template<typename T>
+    static int64_t Of(const T *object) {
+      return 0;
+    }
+
+    static int64_t Of(const git_blob *blob);
+    static int64_t Of(const git_tree *tree);
+    static int64_t Of(const git_diff *diff);
+    static int64_t Of(const git_patch *patch);
+    static int64_t Of(const git_index *index);
+    static int64_t Of(const git_odb_object *object);
+    static int64_t Of(const git_buf *buf);
+
+  private:
+    static NAN_METHOD(Get);
+
+    // Behind a function so types can register before this file's statics
+    // are initialized.
+    static std::vector<Type *> &Types();
+};
+
+#endif
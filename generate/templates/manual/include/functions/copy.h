@@ -14,5 +14,6 @@ const git_index_time *git_index_time_dup(const git_index_time *arg);
 const git_time *git_time_dup(const git_time *arg);
 const git_diff_delta *git_diff_delta_dup(const git_diff_delta *arg);
 const git_diff_file *git_diff_file_dup(const git_diff_file *arg);
+const git_diff_line *git_diff_line_dup(const git_diff_line *arg);
 
 #endif
@@ -0,0 +1,27 @@
+#ifndef OBJECT_CACHE_H
+#define OBJECT_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <git2.h>
+
+/**
+ * Looks an object up in the repository's object cache only. Returns 0 and a
+ * new reference to the object if libgit2 already holds it parsed and of the
+ * given type, and GIT_ENOTFOUND otherwise. It never touches the odb, so it is
+ * cheap enough to call from the loop thread.
+ */
+int nodegit_object_cache_lookup(
+  git_object **out,
+  git_repository *repo,
+  const git_oid *id,
+  git_otype type
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <vector>
+
+/**
+ * Free list of one type of object, used to recycle the batons and workers of
+ * the generated async functions instead of allocating them per call.
+ *
+ * Only used on the loop thread, so there is no locking.
+ */
+template<typename T>
+class ObjectPool {
+  public:
+    static T *Acquire() {
+      if (available.empty()) {
+        return new T();
+      }
+
+      T *object = available.back();
+      available.pop_back();
+      return object;
+    }
+
+    static void Release(T *object) {
+      // Enough to cover a burst of concurrent calls without holding on to
+      // every object a spike ever needed.
+      if (available.size() < 128) {
+        available.push_back(object);
+      }
+      else {
+        delete object;
+      }
+    }
+
+  private:
+    static std::vector<T *> available;
+};
+
+template<typename T>
+std::vector<T *> ObjectPool<T>::available;
+
+#endif
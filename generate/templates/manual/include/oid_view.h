@@ -0,0 +1,39 @@
+#ifndef OID_VIEW_H
+#define OID_VIEW_H
+
+#include <v8.h>
+
+#include "nan.h"
+
+extern "C" {
+  #include <git2.h>
+}
+
+using namespace v8;
+
+/**
+ * An oid can be handed to NodeGit as the 20 raw bytes of a Buffer or
+ * Uint8Array, usually a slice of the Buffer that Oid.fromStrings returns.
+ * Generated functions read the git_oid straight out of the view's memory,
+ * without a wrapper to unwrap or a copy to make.
+ */
+class OidView {
+  public:
+    // Returns NULL if the value isn't a 20 byte view.
+    static git_oid *FromValue(Handle<v8::Value> value) {
+      if (!value->IsObject()) {
+        return NULL;
+      }
+
+      Local<Object> object = value->ToObject();
+
+      if (!object->HasIndexedPropertiesInExternalArrayData()
+          || object->GetIndexedPropertiesExternalArrayDataLength() != GIT_OID_RAWSZ) {
+        return NULL;
+      }
+
+      return (git_oid *)object->GetIndexedPropertiesExternalArrayData();
+    }
+};
+
+#endif
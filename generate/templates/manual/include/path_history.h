@@ -0,0 +1,75 @@
+#ifndef PATH_HISTORY_H
+#define PATH_HISTORY_H
+
+#include <v8.h>
+#include <string>
+#include <vector>
+
+#include "nan.h"
+#include "commit_metadata.h"
+
+extern "C" {
+#include <git2.h>
+}
+
+using namespace v8;
+
+/**
+ * The commits of a walk that touch one path, like
+ * `git log --full-history -- <path>`.
+ *
+ * A commit touches the path when what the path points at differs from every
+ * one of its parents. Every parent of a merge is still walked, not just one
+ * that left the path as it was, so changes on branches that were merged away
+ * show up too. The trees are compared one path component at a time,
+ * and as soon as both sides share a subtree nothing below it is read, so
+ * most commits cost a lookup or two instead of a diff.
+ *
+ * With followRenames, a commit that adds the path is diffed against its
+ * parent to see if the file came from somewhere else. If it did, older
+ * commits are matched against the old path. Like `git log --follow`, this
+ * only makes sense for a single file walked newest first.
+ */
+class PathHistory {
+  public:
+    PathHistory(const char *path, bool followRenames);
+
+    // Reads the commit into the results if it touches the path.
+    int Visit(git_repository *repo, const git_oid *id);
+
+    // Whether the path leads somewhere else in tree than in parentTree,
+    // which is NULL for a root commit.
+    int Differs(git_repository *repo, const git_oid *tree,
+      const git_oid *parentTree, bool *differs) const;
+
+    size_t Count() const {
+      return commits.Count();
+    }
+
+    // The commit columns plus `paths`, what the path was called in each
+    // commit, and `path`, what to carry on the walk with.
+    Handle<Object> ToColumns() const;
+
+  private:
+    enum Change {
+      UNCHANGED,
+      ADDED,
+      DELETED,
+      MODIFIED
+    };
+
+    void SetPath(const std::string &to);
+    int Compare(git_repository *repo, const git_oid *tree,
+      const git_oid *parentTree, Change *change) const;
+    int FindRename(git_repository *repo, git_commit *commit,
+      git_commit *parent);
+
+    std::string path;
+    std::vector<std::string> components;
+    bool followRenames;
+
+    CommitMetadata commits;
+    std::vector<std::string> paths;
+};
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef POOLED_ASYNC_WORKER_H
+#define POOLED_ASYNC_WORKER_H
+
+#include <vector>
+
+#include "nan.h"
+#include "cancel_token.h"
+#include "functions/copy.h"
+#include "object_pool.h"
+#include "promise_factory.h"
+#include "scope.h"
+#include "stats.h"
+#include "thread_pool.h"
+
+extern "C" {
+#include <git2.h>
+}
+
+using namespace v8;
+
+/**
+ * Base for the generated workers. Finished workers go back to an
+ * ObjectPool along with their NanCallback and persistent handle, so a
+ * recycled worker only has to point the callback at a new function.
+ *
+ * Arguments are kept alive in indexed slots of the worker's persistent
+ * object, which is cheaper than SaveToPersistent's named properties. The
+ * slots are cleared before the worker is pooled again.
+ *
+ * A call either has a node style callback or returns a promise made by
+ * PromiseFactory. Subclasses report the outcome through Resolve and Reject,
+ * which settle whichever of the two the call has.
+ *
+ * The hand written methods in manual_functions take the same optional
+ * CancelToken and callback after their own arguments as the generated ones.
+ * Dispatch and Begin read those for them, and their batons, which have the
+ * generated error_code and error, are failed and settled through
+ * IsCancelledBeforeStart, SetResult and RejectBaton.
+ *
+ * A call made in a Scope holds off its disposal until the worker is
+ * destroyed, by which time whatever it returned has joined the scope. So
+ * does every other scope the call was passed wrappers from, as the worker
+ * may still be using them.
+ */
+template<typename T>
+class PooledAsyncWorker : public NanAsyncWorker {
+  public:
+    PooledAsyncWorker()
+      : NanAsyncWorker(new NanCallback())
+      , stats(NULL)
+      , scope(NULL)
+      , rejectCallback(new NanCallback())
+      , settlesPromise(false)
+      , keptAlive(0) {}
+
+    ~PooledAsyncWorker() {
+      delete rejectCallback;
+    }
+
+    // Anything but a function means the call returns a promise, and the
+    // functions that settle it are waiting in PromiseFactory.
+    static T *Acquire(Handle<v8::Value> callback) {
+      T *worker = ObjectPool<T>::Acquire();
+
+      if (callback->IsFunction()) {
+        worker->callback->SetFunction(callback.As<Function>());
+        worker->settlesPromise = false;
+      }
+      else {
+        Local<Function> resolve;
+        Local<Function> reject;
+
+        PromiseFactory::Pop(&resolve, &reject);
+        worker->callback->SetFunction(resolve);
+        worker->rejectCallback->SetFunction(reject);
+        worker->settlesPromise = true;
+      }
+
+      return worker;
+    }
+
+    // Node style when there is a callback at argCount, or right after a
+    // CancelToken there. Otherwise the call returns a promise, and anything
+    // start throws rejects it.
+    static _NAN_METHOD_RETURN_TYPE Dispatch(_NAN_METHOD_ARGS, int argCount,
+        NanFunctionCallback start) {
+      if ((args.Length() > argCount && args[argCount]->IsFunction())
+          || (args.Length() > argCount + 1 && args[argCount + 1]->IsFunction())) {
+        return start(args);
+      }
+
+      if (!PromiseFactory::IsAvailable()) {
+        return NanThrowError("Callback is required and must be a Function.");
+      }
+
+      NanScope();
+      Local<Object> promise = PromiseFactory::Push();
+      TryCatch tryCatch;
+
+      start(args);
+
+      if (tryCatch.HasCaught()) {
+        Local<Function> resolve;
+        Local<Function> reject;
+        Handle<v8::Value> argv[1] = { tryCatch.Exception() };
+
+        PromiseFactory::Pop(&resolve, &reject);
+        reject->Call(NanGetCurrentContext()->Global(), 1, argv);
+      }
+
+      NanReturnValue(promise);
+    }
+
+    // Reads the CancelToken and callback after argCount and acquires a
+    // worker for them, timed under function and joined to scope, or the
+    // scope being run. The method's own arguments have to be checked
+    // first: this throws and returns NULL when the CancelToken isn't one.
+    static T *Begin(_NAN_METHOD_ARGS, int argCount, Stats::Function *function,
+        Scope *joined, CancelToken **cancelToken) {
+      Handle<v8::Value> callback = NanUndefined();
+      Handle<v8::Value> cancelTokenArg = NanUndefined();
+
+      if (args.Length() > argCount && args[argCount]->IsFunction()) {
+        callback = args[argCount];
+      }
+      else {
+        if (args.Length() > argCount) {
+          cancelTokenArg = args[argCount];
+        }
+        if (args.Length() > argCount + 1) {
+          callback = args[argCount + 1];
+        }
+      }
+
+      *cancelToken = NULL;
+      if (!cancelTokenArg->IsUndefined() && !cancelTokenArg->IsNull()) {
+        *cancelToken = CancelToken::FromValue(cancelTokenArg);
+
+        if (*cancelToken == NULL) {
+          NanThrowError("Cancel token must be a CancelToken.");
+          return NULL;
+        }
+      }
+
+      T *worker = Acquire(callback);
+      worker->TrackStats(function);
+      worker->JoinScope(joined ? joined : Scope::Current());
+
+      if (*cancelToken) {
+        worker->KeepAlive(cancelTokenArg);
+      }
+
+      return worker;
+    }
+
+    // At the start of Execute. Fails the baton if the call was cancelled
+    // while it was queued.
+    template<typename Baton>
+    static bool IsCancelledBeforeStart(Baton *baton) {
+      if (!CancelToken::IsCurrentCancelled()) {
+        return false;
+      }
+
+      CancelToken::SetCancelledError();
+      SetResult(baton, GIT_EUSER);
+      return true;
+    }
+
+    // At the end of Execute, keeping libgit2's error if it failed.
+    template<typename Baton>
+    static void SetResult(Baton *baton, int result) {
+      baton->error_code = result;
+
+      if (result != GIT_OK && giterr_last() != NULL) {
+        baton->error = git_error_dup(giterr_last());
+      }
+    }
+
+    // Rejects with the baton's error, which is freed.
+    template<typename Baton>
+    void RejectBaton(Baton *baton) {
+      if (baton->error) {
+        Reject(NanError(baton->error->message));
+        if (baton->error->message)
+          free((void *)baton->error->message);
+        free((void *)baton->error);
+        baton->error = NULL;
+      } else {
+        Reject(NanError("Unknown Error"));
+      }
+    }
+
+    // NanAsyncWorker would delete the callback here; a pooled worker keeps
+    // it for the next call.
+    void WorkComplete() {
+      NanScope();
+
+      if (ErrorMessage() == NULL) {
+        HandleOKCallback();
+      }
+      else {
+        HandleErrorCallback();
+      }
+    }
+
+    void HandleErrorCallback() {
+      NanScope();
+
+      Reject(NanError(ErrorMessage()));
+    }
+
+    void Resolve(Handle<v8::Value> value) {
+      if (settlesPromise) {
+        Handle<v8::Value> argv[1] = { value };
+        callback->Call(1, argv);
+      }
+      else {
+        Handle<v8::Value> argv[2] = { NanNull(), value };
+        callback->Call(2, argv);
+      }
+    }
+
+    void Reject(Handle<v8::Value> error) {
+      Handle<v8::Value> argv[1] = { error };
+
+      if (settlesPromise) {
+        rejectCallback->Call(1, argv);
+      }
+      else {
+        callback->Call(1, argv);
+      }
+    }
+
+    // Stats are only kept for calls that start while recording is on.
+    void TrackStats(Stats::Function *function) {
+      stats = Stats::IsEnabled() ? function : NULL;
+      timing.queuedAt = 0;
+      timing.startedAt = 0;
+      timing.finishedAt = 0;
+    }
+
+    void JoinScope(Scope *joined,
+        const std::vector<Scope *> &held = std::vector<Scope *>()) {
+      scope = joined;
+
+      if (scope) {
+        scope->Enter();
+        KeepAlive(NanObjectWrapHandle(joined));
+      }
+
+      for (size_t i = 0; i < held.size(); i++) {
+        if (held[i] != joined) {
+          held[i]->Enter();
+          KeepAlive(NanObjectWrapHandle(held[i]));
+          heldScopes.push_back(held[i]);
+        }
+      }
+    }
+
+    ThreadPool::Timing *GetTiming() {
+      return stats ? &timing : NULL;
+    }
+
+    void Queue(ThreadPool::Priority priority, const void *repo,
+        ThreadPool::Access access, CancelToken *cancelToken) {
+      ThreadPool::QueueWork(this, priority, repo, access, cancelToken,
+        GetTiming());
+    }
+
+    // For a call answered without a trip to the pool, such as a cache hit.
+    // A promise is settled right away, but a node style callback is never
+    // called before the call that took it has returned.
+    void Finish() {
+      if (settlesPromise) {
+        WorkComplete();
+        Destroy();
+      }
+      else {
+        ThreadPool::CompleteWork(this);
+      }
+    }
+
+    void KeepAlive(Handle<v8::Value> value) {
+      NanScope();
+      NanNew(persistentHandle)->Set(keptAlive++, value);
+    }
+
+    void Destroy() {
+      NanScope();
+      Local<Object> handle = NanNew(persistentHandle);
+
+      if (scope) {
+        scope->Leave();
+        scope = NULL;
+      }
+
+      for (size_t i = 0; i < heldScopes.size(); i++) {
+        heldScopes[i]->Leave();
+      }
+      // Keeps its storage for the next call.
+      heldScopes.clear();
+
+      for (uint32_t i = 0; i < keptAlive; i++) {
+        handle->Set(i, NanUndefined());
+      }
+      keptAlive = 0;
+
+      ObjectPool<T>::Release(static_cast<T *>(this));
+    }
+
+  protected:
+    Stats::Function *stats;
+    ThreadPool::Timing timing;
+    Scope *scope;
+
+  private:
+    NanCallback *rejectCallback;
+    bool settlesPromise;
+    uint32_t keptAlive;
+    std::vector<Scope *> heldScopes;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PROMISE_FACTORY_H
+#define PROMISE_FACTORY_H
+
+#include <v8.h>
+#include <node.h>
+#include <map>
+
+#include "nan.h"
+
+using namespace node;
+using namespace v8;
+
+/**
+ * Creates the promises that async methods return when they are called
+ * without a callback. lib/nodegit.js hands it the Promise constructor through
+ * `NodeGit.setPromiseConstructor`.
+ *
+ * A promise is made with a native executor that pushes its resolve and
+ * reject functions onto a stack, where the worker for the call picks them
+ * up. Calls that start while another one is reading its arguments nest, so
+ * a stack keeps each pair with its own promise.
+ */
+class PromiseFactory {
+  public:
+    static void InitializeComponent(Handle<v8::Object> target);
+
+    static bool IsAvailable();
+
+    // Returns a pending promise and pushes the functions that settle it.
+    static Local<Object> Push();
+    // Takes the functions pushed by the latest Push.
+    static void Pop(Local<Function> *resolve, Local<Function> *reject);
+
+    // Settles baton through fulfilled or rejected once a promise returned by
+    // a JS callback settles. The handler functions are made once for each
+    // callback and bound to a holder of the baton for each call.
+    static void Then(Handle<Object> promise, Handle<Function> then,
+      NanFunctionCallback fulfilled, NanFunctionCallback rejected,
+      void *baton);
+    // In a handler, takes the baton from its holder. Only the first handler
+    // to run for a call gets it, however often a thenable calls them; the
+    // rest get NULL.
+    static void *TakeBaton(Handle<v8::Value> holder);
+
+  private:
+    static NAN_METHOD(SetConstructor);
+    static NAN_METHOD(Executor);
+
+    static Local<Function> Handler(NanFunctionCallback callback);
+
+    static Persistent<Function> constructor;
+    static Persistent<Function> executor;
+    static Persistent<Array> pending;
+    static std::map<NanFunctionCallback, Persistent<Function> *> handlers;
+};
+
+#endif
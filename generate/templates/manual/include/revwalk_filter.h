@@ -0,0 +1,104 @@
+#ifndef REVWALK_FILTER_H
+#define REVWALK_FILTER_H
+
+#include <v8.h>
+#include <node.h>
+#include <regex.h>
+#include <string.h>
+#include <uv.h>
+#include <unordered_set>
+#include <vector>
+
+#include "nan.h"
+#include "path_history.h"
+
+extern "C" {
+#include <git2.h>
+}
+
+using namespace node;
+using namespace v8;
+
+/**
+ * `NodeGit.RevwalkFilter`, which commits of a walk to give back. It is
+ * checked on the worker, so the commits it rejects never reach JavaScript.
+ *
+ * A commit passes when all of these that are set hold:
+ * - its author and committer match their POSIX extended regular
+ *   expressions, each with its own case flag, tried against "Name <email>"
+ *   like `git log -E --author`;
+ * - its commit time is within since and until;
+ * - its parent count is within minParents and maxParents;
+ * - it changes something under one of paths, as
+ *   `git log --full-history -- <paths>` would list it.
+ *
+ * hide works differently. Once Revwalk#addHideCb gives the filter to a
+ * walk, every commit in the set and all of its ancestors are left out, just
+ * as if each one had been passed to Revwalk#hide. The set is a hash set
+ * that the walk looks commits up in as it goes, so nothing has to be pushed
+ * up front.
+ *
+ * Some regexec implementations, like the one bundled for Windows, write to
+ * the pattern while matching, so matching is serialized per filter for
+ * walks that share one.
+ */
+class RevwalkFilter : public ObjectWrap {
+  public:
+    static Persistent<FunctionTemplate> constructor_template;
+    static void InitializeComponent(Handle<v8::Object> target);
+
+    // Returns NULL if the value isn't a RevwalkFilter.
+    static RevwalkFilter *FromValue(Handle<v8::Value> value);
+
+    // Worker threads.
+    int Matches(git_repository *repo, const git_oid *id, bool *matches) const;
+
+    // A git_revwalk_hide_cb for the hide set, with the filter as payload.
+    static int Hide(const git_oid *id, void *payload);
+
+  private:
+    struct OidHash {
+      size_t operator()(const git_oid &id) const {
+        size_t hash;
+        memcpy(&hash, id.id, sizeof(hash));
+        return hash;
+      }
+    };
+
+    struct OidEqual {
+      bool operator()(const git_oid &a, const git_oid &b) const {
+        return git_oid_equal(&a, &b) != 0;
+      }
+    };
+
+    RevwalkFilter();
+    ~RevwalkFilter();
+
+    static NAN_METHOD(JSNewFunction);
+
+    // Sets up the filter from the constructor's options, returning the
+    // error to throw, if any.
+    const char *Configure(Handle<Object> options);
+    const char *Compile(regex_t *pattern, bool *compiled,
+      Handle<v8::Value> source, Handle<v8::Value> ignoreCase);
+
+    bool MatchesPerson(const regex_t *pattern,
+      const git_signature *person) const;
+    int ChangesPaths(git_repository *repo, git_commit *commit,
+      bool *changes) const;
+
+    regex_t author;
+    regex_t committer;
+    bool hasAuthor;
+    bool hasCommitter;
+    git_time_t since;
+    git_time_t until;
+    unsigned int minParents;
+    unsigned int maxParents;
+    std::unordered_set<git_oid, OidHash, OidEqual> hidden;
+    std::vector<PathHistory *> paths;
+    mutable uv_mutex_t matching;
+    char error[256];
+};
+
+#endif
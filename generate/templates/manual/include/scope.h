@@ -0,0 +1,134 @@
+#ifndef SCOPE_H
+#define SCOPE_H
+
+#include <v8.h>
+#include <node.h>
+#include <stdint.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "nan.h"
+
+using namespace node;
+using namespace v8;
+
+/**
+ * `NodeGit.Scope`, which frees every object made inside it at once.
+ *
+ * A wrapper joins a scope when the call that made it was made on a wrapper
+ * in the scope, was passed one, or was started inside `scope.run(fn)`. A
+ * call that uses wrappers from several scopes makes its wrappers join the
+ * first of them, and holds off the disposal of every one of them.
+ * Disposing of the scope frees the objects that were handed over to
+ * JavaScript and clears every wrapper, newest first, so anything used after
+ * that throws instead of touching freed memory. Calls still running when
+ * the scope is disposed of are waited for; what they return is disposed of
+ * as soon as they finish.
+ *
+ * Everything happens on the loop thread.
+ */
+class Scope : public ObjectWrap {
+  public:
+    // Frees a tracked wrapper's object if it owns it and clears it.
+    typedef void (*Disposer)(ObjectWrap *wrapper);
+
+    static Persistent<FunctionTemplate> constructor_template;
+    static void InitializeComponent(Handle<v8::Object> target);
+
+    // Wrappers made while this is in scope join `scope`.
+    class Creating {
+      public:
+        Creating(Scope *scope) : previous(current), ended(false) {
+          current = scope;
+        }
+
+        ~Creating() {
+          End();
+        }
+
+        // Before handing control back to JavaScript.
+        void End() {
+          if (!ended) {
+            current = previous;
+            ended = true;
+          }
+        }
+
+      private:
+        Scope *previous;
+        bool ended;
+    };
+
+    // The distinct scopes of what a call was made on and was passed, in
+    // order. Only allocates when there is more than one.
+    class CallScopes {
+      public:
+        CallScopes() : first(NULL) {}
+
+        void Add(Scope *scope) {
+          if (scope == NULL || scope == first) {
+            return;
+          }
+
+          if (first == NULL) {
+            first = scope;
+          }
+          else if (std::find(others.begin(), others.end(), scope) == others.end()) {
+            others.push_back(scope);
+          }
+        }
+
+        // The one the call's wrappers join.
+        Scope *First() const {
+          return first;
+        }
+
+        const std::vector<Scope *> &Others() const {
+          return others;
+        }
+
+      private:
+        Scope *first;
+        std::vector<Scope *> others;
+    };
+
+    static Scope *Current() {
+      return current;
+    }
+
+    // Returns the entry to Forget the wrapper by, or 0 if the scope has
+    // already been disposed of and won't take it.
+    uint64_t Track(ObjectWrap *wrapper, Disposer disposer);
+    void Forget(uint64_t entry);
+
+    // Around an async call whose results join the scope.
+    void Enter();
+    void Leave();
+
+  private:
+    struct Entry {
+      ObjectWrap *wrapper;
+      Disposer disposer;
+    };
+
+    Scope();
+
+    void DisposeAll();
+
+    static NAN_METHOD(JSNewFunction);
+    static NAN_METHOD(Run);
+    static NAN_METHOD(Dispose);
+    static NAN_METHOD(Size);
+
+    // Ordered, so the newest are disposed of first.
+    std::map<uint64_t, Entry> entries;
+    uint64_t nextEntry;
+    unsigned int pending;
+    bool disposing;
+    bool disposed;
+
+    static Scope *current;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <v8.h>
+#include <uv.h>
+#include <stdint.h>
+#include <vector>
+
+#include "nan.h"
+#include "thread_pool.h"
+
+using namespace v8;
+
+/**
+ * `NodeGit.Stats`, timings for every generated binding.
+ *
+ * Async calls record how long they waited in the thread pool, how long
+ * libgit2 ran and how long HandleOKCallback spent converting the result.
+ * Sync calls record how long they held up the event loop.
+ *
+ * Recording is off unless NODEGIT_STATS is set or `Stats.enable()` is
+ * called. While it is off, a call pays for one branch. Everything is
+ * recorded on the loop thread, so nothing is locked.
+ */
+class Stats {
+  public:
+    // Power of two buckets of microseconds, the last one open ended.
+    class Histogram {
+      public:
+        static const int BUCKETS = 24;
+
+        void Record(uint64_t nanoseconds);
+        void Reset();
+        Local<Object> ToObject();
+
+        uint64_t Count() {
+          return count;
+        }
+
+      private:
+        uint64_t count;
+        uint64_t total;
+        uint64_t max;
+        uint64_t buckets[BUCKETS];
+    };
+
+    struct Function {
+      const char *name;
+      uint64_t calls;
+      Histogram queueWait;
+      Histogram execute;
+      Histogram complete;
+      Histogram sync;
+    };
+
+    // Times a sync call for as long as it is in scope.
+    class SyncTimer {
+      public:
+        SyncTimer(Function *function)
+          : function(enabled ? function : NULL)
+          , startedAt(enabled ? uv_hrtime() : 0) {}
+        ~SyncTimer();
+
+      private:
+        Function *function;
+        uint64_t startedAt;
+    };
+
+    // Records an async call once HandleOKCallback is done with it. The pool
+    // timing is missing for calls that never went through the pool.
+    class CompletionTimer {
+      public:
+        CompletionTimer(Function *function, const ThreadPool::Timing *timing)
+          : function(function)
+          , timing(timing)
+          , startedAt(function ? uv_hrtime() : 0) {}
+        ~CompletionTimer();
+
+      private:
+        Function *function;
+        const ThreadPool::Timing *timing;
+        uint64_t startedAt;
+    };
+
+    static void InitializeComponent(Handle<v8::Object> target);
+
+    // Called once per binding, from a function local static.
+    static Function *Register(const char *name);
+
+    static bool IsEnabled() {
+      return enabled;
+    }
+
+  private:
+    static NAN_METHOD(Enable);
+    static NAN_METHOD(Disable);
+    static NAN_METHOD(JSIsEnabled);
+    static NAN_METHOD(Reset);
+    static NAN_METHOD(Get);
+
+    static bool enabled;
+    static std::vector<Function *> functions;
+};
+
+#endif
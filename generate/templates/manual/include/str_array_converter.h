@@ -5,6 +5,7 @@
 
 #include "nan.h"
 #include "git2/strarray.h"
+#include "argument_arena.h"
 
 using namespace v8;
 
@@ -12,12 +13,16 @@ class StrArrayConverter {
   public:
 
     static git_strarray *Convert (Handle<v8::Value> val);
+    // Same, but backed by the arena of the call the array is passed to.
+    static git_strarray *Convert (Handle<v8::Value> val, ArgumentArena &arena);
 
   private:
-    static git_strarray *ConvertArray(Array *val);
-    static git_strarray *ConvertString(Handle<String> val);
-    static git_strarray *AllocStrArray(const size_t count);
-    static git_strarray *ConstructStrArray(int argc, char** argv);
+    static git_strarray *ConvertValue(Handle<v8::Value> val, ArgumentArena *arena);
+    static git_strarray *ConvertArray(Array *val, ArgumentArena *arena);
+    static git_strarray *ConvertString(Handle<String> val, ArgumentArena *arena);
+    static git_strarray *AllocStrArray(const size_t count, ArgumentArena *arena);
+    static git_strarray *ConstructStrArray(int argc, char** argv, ArgumentArena *arena);
+    static char *CopyString(const char *str, ArgumentArena *arena);
 };
 
 #endif
@@ -0,0 +1,156 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <deque>
+#include <map>
+#include <queue>
+#include <uv.h>
+
+#include "nan.h"
+#include "cancel_token.h"
+
+using namespace v8;
+
+/**
+ * Runs the generated async workers on threads owned by nodegit instead of
+ * the libuv pool, so long clones or diffs never hold up fs, dns or zlib.
+ *
+ * Work is queued as either INTERACTIVE or BULK. Bulk work never occupies
+ * more than `size - 1` threads, which leaves a thread free for lookups while
+ * a fetch or checkout is running.
+ *
+ * The size defaults to NODEGIT_THREADPOOL_SIZE (or 4) and can be changed at
+ * runtime through `NodeGit.ThreadPool.setSize`. Threads are started as work
+ * arrives; shrinking parks the extra threads rather than joining them.
+ *
+ * Work tagged with a repository is also ordered per repository: readers of a
+ * repository run side by side, a writer waits for them and runs alone, and
+ * anything queued behind a writer waits its turn. Work on other repositories
+ * is never held up by this.
+ *
+ * The exception is work a JS callback queues on the repository of the job
+ * that called it, while that job waits for the callback. The callback may
+ * well be waiting for that very work, so it is let in straight away, as part
+ * of the job, instead of waiting behind it (or behind a writer queued after
+ * it) forever. Only work queued while the callback itself runs counts; work
+ * queued later on, from a promise the callback returned, takes its turn.
+ *
+ * A thread waiting for a JS callback doesn't count against the size either,
+ * as the callback may be waiting for a thread itself. Spare threads are
+ * started in its place, up to a fixed number past the size.
+ */
+class ThreadPool {
+  private:
+    struct Work;
+
+  public:
+    // Marks the worker thread it is made on as waiting for a JS callback
+    // while it is in scope.
+    class CallbackWait {
+      public:
+        CallbackWait();
+        ~CallbackWait();
+
+      private:
+        // NULL when not made on a pool thread.
+        const Work *work;
+    };
+
+    enum Priority {
+      INTERACTIVE = 0,
+      BULK = 1
+    };
+
+    enum Access {
+      READ,
+      WRITE
+    };
+
+    // When the work was queued, started and finished, in uv_hrtime
+    // nanoseconds. Written by the worker thread before the work completes.
+    struct Timing {
+      uint64_t queuedAt;
+      uint64_t startedAt;
+      uint64_t finishedAt;
+    };
+
+    static void InitializeComponent(Handle<v8::Object> target);
+
+    // Loop thread only; the worker is completed and destroyed on the loop.
+    // `repo` may be NULL for work that isn't tied to a repository, `token`
+    // for work that can't be cancelled and `timing` for work nobody times.
+    static void QueueWork(
+      NanAsyncWorker *worker,
+      Priority priority,
+      const void *repo = NULL,
+      Access access = READ,
+      CancelToken *token = NULL,
+      Timing *timing = NULL
+    );
+
+    // Loop thread only. Completes and destroys work that never needed a
+    // thread on a later turn of the loop, as if it had been queued.
+    static void CompleteWork(NanAsyncWorker *worker);
+
+  private:
+    struct Work {
+      NanAsyncWorker *worker;
+      Priority priority;
+      const void *repo;
+      Access access;
+      CancelToken *token;
+      Timing *timing;
+      uint64_t queuedAt;
+    };
+
+    // Only touched on the loop thread.
+    struct RepoState {
+      unsigned int readers;
+      // Only ever more than one while a writer waits for a callback.
+      unsigned int writers;
+      std::deque<Work> waiting;
+    };
+
+    struct Counters {
+      unsigned int completed;
+      uint64_t totalWait;
+      uint64_t maxWait;
+      uint64_t totalRun;
+    };
+
+    static bool Admit(const Work &work, bool forCallback);
+    static void Release(const Work &work);
+    static void Dispatch(const Work &work);
+    static unsigned int Capacity();
+    static void SpawnIfNeeded();
+    static bool CanRun(unsigned int index);
+    static void RunThread(void *data);
+    static void Completed(uv_async_t *handle, int status);
+
+    static NAN_METHOD(SetSize);
+    static NAN_METHOD(GetSize);
+    static NAN_METHOD(GetStats);
+
+    static unsigned int size;
+    static unsigned int threadCount;
+    static std::queue<Work> queues[2];
+    static unsigned int running[2];
+    // Threads waiting for a JS callback, left out of `running`.
+    static unsigned int released;
+    static Counters counters[2];
+    static unsigned int outstanding;
+
+    static std::map<const void *, RepoState> repos;
+    static unsigned int blocked;
+
+    // The work a worker thread is running.
+    static uv_key_t currentWork;
+
+    static std::queue<Work> completed;
+    static uv_async_t completedHandle;
+
+    static uv_mutex_t mutex;
+    static uv_cond_t available;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef TRACE_BUFFER_H
+#define TRACE_BUFFER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <uv.h>
+
+extern "C" {
+#include <git2.h>
+}
+
+/**
+ * Where libgit2's trace messages go while `NodeGit.Trace` is on.
+ *
+ * libgit2 traces from whichever thread is doing the work, so Write may be
+ * called from any number of pool threads at once. It claims a slot with a
+ * compare and swap and never waits for anything: when every slot is still
+ * waiting to be drained, the message is counted as dropped instead.
+ *
+ * Only the loop thread reads, so reading needs no compare and swap. A slot
+ * that has been claimed but not written yet ends the read; the rest come
+ * with the next drain.
+ *
+ * nodegit's own messages, such as the thread pool's, go through Trace,
+ * which keeps to the level tracing was turned on at like libgit2 does.
+ */
+class TraceBuffer {
+  public:
+    // A power of two, so positions can wrap around freely.
+    static const uint32_t CAPACITY = 1024;
+    // Longer messages are cut short.
+    static const size_t MESSAGE_SIZE = 256;
+
+    struct Entry {
+      git_trace_level_t level;
+      // uv_hrtime nanoseconds, the clock process.hrtime uses.
+      uint64_t time;
+      char message[MESSAGE_SIZE];
+    };
+
+    // Loop thread, before tracing is turned on.
+    static void Initialize();
+
+    // A git_trace_callback, safe on any thread.
+    static void Write(git_trace_level_t level, const char *message);
+
+    // Loop thread, along with git_trace_set.
+    static void SetLevel(git_trace_level_t level);
+
+    // Safe on any thread. Dropped unless tracing is on at `level` or above.
+    static void Trace(git_trace_level_t level, const char *format, ...);
+
+    // Loop thread only. False once there is nothing left to read.
+    static bool Read(Entry *entry);
+
+    // How many messages didn't fit since the last call.
+    static uint32_t TakeDropped();
+
+  private:
+    struct Slot {
+      // Equal to the position it can be written at while the slot is free,
+      // and to that position + 1 once the entry can be read.
+      std::atomic<uint32_t> sequence;
+      Entry entry;
+    };
+
+    static Slot slots[CAPACITY];
+    static std::atomic<uint32_t> head;
+    static uint32_t tail;
+    static std::atomic<uint32_t> dropped;
+    static std::atomic<int> level;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef TREE_WALK_H
+#define TREE_WALK_H
+
+#include <v8.h>
+#include <node.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "nan.h"
+
+extern "C" {
+#include <git2.h>
+}
+
+using namespace node;
+using namespace v8;
+
+/**
+ * A run of entries from a TreeWalk, copied out on a worker and handed to
+ * JavaScript as parallel arrays, like CommitMetadata.
+ */
+class TreeWalkBatch {
+  public:
+    void Add(const std::string &path, const git_oid *id, uint32_t mode);
+
+    size_t Count() const {
+      return ids.size();
+    }
+
+    // On the loop thread, once the worker is done.
+    Handle<Object> ToColumns() const;
+
+  private:
+    std::vector<std::string> paths;
+    std::vector<git_oid> ids;
+    std::vector<uint32_t> modes;
+};
+
+/**
+ * `NodeGit.TreeWalk`, a walk over everything under a tree that stops
+ * whenever a batch is full and carries on from there with the next one.
+ * git_tree_walk can't do that, as it only stops for good.
+ *
+ * Entries come depth first, each tree before what is in it, or after it
+ * with postOrder. With blobsOnly only blobs and executables are given back.
+ * With paths, only what is at or under one of them is given back, and
+ * subtrees that can't hold any of them are never read.
+ *
+ * The walk is bound to the tree of the first batch. Only one batch can be
+ * read at a time.
+ */
+class TreeWalk : public ObjectWrap {
+  public:
+    static Persistent<FunctionTemplate> constructor_template;
+    static void InitializeComponent(Handle<v8::Object> target);
+
+    // Returns NULL if the value isn't a TreeWalk.
+    static TreeWalk *FromValue(Handle<v8::Value> value);
+
+    // Worker threads. Adds up to max entries to out, so fewer than that
+    // means the walk is over.
+    int Next(TreeWalkBatch *out, git_tree *tree, size_t max);
+
+  private:
+    // A tree being walked, and the entry it was reached through.
+    struct Level {
+      git_tree *tree;
+      size_t index;
+      std::string prefix;
+      std::string path;
+      git_oid id;
+      bool wanted;
+    };
+
+    enum Relation {
+      OUTSIDE,
+      ABOVE,
+      INSIDE
+    };
+
+    TreeWalk();
+    ~TreeWalk();
+
+    static NAN_METHOD(JSNewFunction);
+
+    // Sets up the walk from the constructor's options, returning the error
+    // to throw, if any.
+    const char *Configure(Handle<Object> options);
+
+    // Where path is in relation to paths. Only a tree can be ABOVE one.
+    Relation RelationTo(const std::string &path, bool isTree) const;
+
+    bool started;
+    bool postOrder;
+    bool blobsOnly;
+    std::vector<std::string> paths;
+    std::vector<Level> stack;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../include/argument_arena.h"
+
+ArgumentArena::ArgumentArena() {
+  this->used = 0;
+}
+
+ArgumentArena::~ArgumentArena() {
+  this->Reset();
+}
+
+void ArgumentArena::Reset() {
+  for (size_t i = 0; i < this->spilled.size(); i++) {
+    free(this->spilled[i]);
+  }
+
+  this->spilled.clear();
+  this->used = 0;
+}
+
+void *ArgumentArena::Alloc(size_t size) {
+  // Keep every allocation aligned for the widest member of a libgit2 struct.
+  size_t aligned = (size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+
+  if (aligned <= INLINE_SIZE - this->used) {
+    void *result = (char *)this->storage + this->used;
+    this->used += aligned;
+    return result;
+  }
+
+  void *result = malloc(size);
+  this->spilled.push_back(result);
+  return result;
+}
+
+char *ArgumentArena::Strdup(const char *str) {
+  size_t length = strlen(str) + 1;
+  char *result = (char *)this->Alloc(length);
+
+  memcpy(result, str, length);
+  return result;
+}
@@ -0,0 +1,261 @@
+#include <nan.h>
+#include <algorithm>
+#include <vector>
+#include <uv.h>
+
+#include "../include/callback_batch.h"
+#include "../include/thread_pool.h"
+
+using namespace v8;
+
+void CallbackBatch::Initialize() {
+  uv_key_create(&pushed);
+}
+
+CallbackBatch::CallbackBatch(
+  NanCallback *callback,
+  Release release,
+  size_t size,
+  unsigned int wait,
+  bool coalesce
+) {
+  this->callback = callback;
+  this->release = release;
+  this->size = size > 0 ? size : 1;
+  this->wait = (uint64_t)wait * 1000; // uv_hrtime is in nanoseconds
+  this->coalesce = coalesce;
+  this->firstQueued = 0;
+  this->result = 0;
+  this->pending = false;
+  this->draining = false;
+  this->deliver = NULL;
+  this->references = 1;
+
+  uv_mutex_init(&this->mutex);
+  uv_sem_init(&this->semaphore, 0);
+}
+
+CallbackBatch::~CallbackBatch() {
+  for (size_t i = 0; i < this->entries.size(); i++) {
+    this->release(this->entries[i]);
+  }
+
+  uv_mutex_destroy(&this->mutex);
+  uv_sem_destroy(&this->semaphore);
+}
+
+bool CallbackBatch::Unreference() {
+  return --this->references == 0;
+}
+
+void CallbackBatch::Dispose() {
+  bool last;
+
+  uv_mutex_lock(&this->mutex);
+  this->callback = NULL;
+  last = this->Unreference();
+  uv_mutex_unlock(&this->mutex);
+
+  if (last) {
+    delete this;
+  }
+}
+
+CallbackBatch *CallbackBatch::FromFunction(
+  Handle<Function> fn,
+  NanCallback *callback,
+  Release release,
+  size_t defaultSize,
+  unsigned int defaultWait,
+  bool coalesce
+) {
+  Local<Value> batch = fn->Get(NanNew("batch"));
+
+  if (!batch->IsObject()) {
+    return NULL;
+  }
+
+  Local<Value> size = batch->ToObject()->Get(NanNew("size"));
+  Local<Value> wait = batch->ToObject()->Get(NanNew("wait"));
+
+  return new CallbackBatch(
+    callback,
+    release,
+    size->IsNumber() ? (size_t)size->Uint32Value() : defaultSize,
+    wait->IsNumber() ? wait->Uint32Value() : defaultWait,
+    coalesce
+  );
+}
+
+int CallbackBatch::Push(void *entry, CallbackDispatcher::Handler deliver) {
+  std::vector<CallbackBatch *> *batches =
+    static_cast<std::vector<CallbackBatch *> *>(uv_key_get(&pushed));
+
+  if (batches == NULL) {
+    batches = new std::vector<CallbackBatch *>();
+    uv_key_set(&pushed, batches);
+  }
+
+  // Held until FlushPushed, so the owner can let go of it mid job.
+  if (std::find(batches->begin(), batches->end(), this) == batches->end()) {
+    uv_mutex_lock(&this->mutex);
+    this->references++;
+    this->deliver = deliver;
+    uv_mutex_unlock(&this->mutex);
+
+    batches->push_back(this);
+  }
+
+  if (this->coalesce) {
+    void *replaced = NULL;
+    bool schedule;
+    int result;
+
+    uv_mutex_lock(&this->mutex);
+    if (!this->entries.empty()) {
+      replaced = this->entries.back();
+      this->entries.clear();
+    }
+    this->entries.push_back(entry);
+    schedule = !this->pending;
+    this->pending = true;
+    if (schedule) {
+      this->references++;
+    }
+    result = this->result;
+    uv_mutex_unlock(&this->mutex);
+
+    if (replaced) {
+      this->release(replaced);
+    }
+
+    if (schedule) {
+      CallbackDispatcher::Enqueue(deliver, this);
+    }
+
+    return result;
+  }
+
+  // JS asked to stop on the previous batch; keep telling libgit2 so.
+  if (this->result != 0) {
+    this->release(entry);
+    return this->result;
+  }
+
+  if (this->entries.empty()) {
+    this->firstQueued = uv_hrtime();
+  }
+
+  this->entries.push_back(entry);
+
+  if (this->entries.size() >= this->size
+      || uv_hrtime() - this->firstQueued >= this->wait) {
+    this->Flush(deliver);
+  }
+
+  return this->result;
+}
+
+void CallbackBatch::Flush(CallbackDispatcher::Handler deliver) {
+  if (this->coalesce || this->entries.empty()) {
+    return;
+  }
+
+  uv_mutex_lock(&this->mutex);
+  this->references++;
+  uv_mutex_unlock(&this->mutex);
+
+  ThreadPool::CallbackWait callbackWait;
+
+  CallbackDispatcher::Enqueue(deliver, this);
+  uv_sem_wait(&this->semaphore);
+}
+
+void CallbackBatch::Drain() {
+  if (!this->coalesce) {
+    this->Flush(this->deliver);
+    return;
+  }
+
+  bool wait;
+
+  // A delivery is already queued for whatever is pending, so only wait.
+  uv_mutex_lock(&this->mutex);
+  wait = this->pending;
+  this->draining = wait;
+  uv_mutex_unlock(&this->mutex);
+
+  if (wait) {
+    ThreadPool::CallbackWait callbackWait;
+
+    uv_sem_wait(&this->semaphore);
+  }
+}
+
+void CallbackBatch::FlushPushed() {
+  std::vector<CallbackBatch *> *batches =
+    static_cast<std::vector<CallbackBatch *> *>(uv_key_get(&pushed));
+
+  if (batches == NULL) {
+    return;
+  }
+
+  for (size_t i = 0; i < batches->size(); i++) {
+    CallbackBatch *batch = (*batches)[i];
+    bool last;
+
+    batch->Drain();
+
+    uv_mutex_lock(&batch->mutex);
+    last = batch->Unreference();
+    uv_mutex_unlock(&batch->mutex);
+
+    if (last) {
+      delete batch;
+    }
+  }
+
+  batches->clear();
+}
+
+std::vector<void *> CallbackBatch::Take() {
+  std::vector<void *> taken;
+
+  uv_mutex_lock(&this->mutex);
+  std::swap(taken, this->entries);
+  this->pending = false;
+  uv_mutex_unlock(&this->mutex);
+
+  return taken;
+}
+
+void CallbackBatch::Delivered(std::vector<void *> &entries, int result) {
+  for (size_t i = 0; i < entries.size(); i++) {
+    this->release(entries[i]);
+  }
+
+  bool last;
+  bool waited;
+
+  uv_mutex_lock(&this->mutex);
+  this->result = result;
+  last = this->Unreference();
+  // A drain waits for the last delivery, not one taken before it started.
+  waited = !this->coalesce || (this->draining && !this->pending);
+  if (waited) {
+    this->draining = false;
+  }
+  uv_mutex_unlock(&this->mutex);
+
+  // The worker waiting on a flush holds a reference, so the batch can't have
+  // been deleted while it waits.
+  if (waited) {
+    uv_sem_post(&this->semaphore);
+  }
+
+  if (last) {
+    delete this;
+  }
+}
+
+uv_key_t CallbackBatch::pushed;
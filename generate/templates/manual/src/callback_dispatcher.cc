@@ -0,0 +1,57 @@
+#include <queue>
+#include <uv.h>
+
+#include "../include/callback_dispatcher.h"
+
+void CallbackDispatcher::Initialize() {
+  uv_mutex_init(&mutex);
+  uv_key_create(&origins);
+  uv_async_init(uv_default_loop(), &handle, (uv_async_cb) Drain);
+
+  // Pending callbacks always belong to a queued worker, which already keeps
+  // the loop alive, so the dispatcher itself shouldn't.
+  uv_unref((uv_handle_t *) &handle);
+}
+
+void CallbackDispatcher::Enqueue(Handler handler, void *baton) {
+  Job job = { handler, baton, uv_key_get(&origins) };
+
+  uv_mutex_lock(&mutex);
+  jobs.push(job);
+  uv_mutex_unlock(&mutex);
+
+  uv_async_send(&handle);
+}
+
+void CallbackDispatcher::Drain(uv_async_t *handle, int status) {
+  std::queue<Job> pending;
+
+  // Swap the queue out so handlers that re-enqueue themselves are picked up
+  // on the next wakeup instead of spinning inside this one.
+  uv_mutex_lock(&mutex);
+  std::swap(pending, jobs);
+  uv_mutex_unlock(&mutex);
+
+  while (!pending.empty()) {
+    Job job = pending.front();
+    pending.pop();
+
+    running = job.origin;
+    job.handler(job.baton);
+    running = NULL;
+  }
+}
+
+void CallbackDispatcher::SetOrigin(const void *origin) {
+  uv_key_set(&origins, (void *)origin);
+}
+
+const void *CallbackDispatcher::Origin() {
+  return running;
+}
+
+uv_async_t CallbackDispatcher::handle;
+uv_mutex_t CallbackDispatcher::mutex;
+std::queue<CallbackDispatcher::Job> CallbackDispatcher::jobs;
+uv_key_t CallbackDispatcher::origins;
+const void *CallbackDispatcher::running = NULL;
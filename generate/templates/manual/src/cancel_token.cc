@@ -0,0 +1,100 @@
+#include <nan.h>
+#include <node.h>
+#include <uv.h>
+
+extern "C" {
+  #include <git2.h>
+}
+
+#include "../include/cancel_token.h"
+
+using namespace v8;
+using namespace node;
+
+CancelToken::CancelToken() {
+  this->cancelled = false;
+  uv_mutex_init(&this->mutex);
+}
+
+CancelToken::~CancelToken() {
+  uv_mutex_destroy(&this->mutex);
+}
+
+void CancelToken::InitializeComponent(Handle<v8::Object> target) {
+  NanScope();
+
+  uv_key_create(&current);
+
+  Local<FunctionTemplate> tpl = NanNew<FunctionTemplate>(JSNewFunction);
+
+  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->SetClassName(NanNew<String>("CancelToken"));
+
+  NODE_SET_PROTOTYPE_METHOD(tpl, "cancel", Cancel);
+  NODE_SET_PROTOTYPE_METHOD(tpl, "isCancelled", JSIsCancelled);
+
+  NanAssignPersistent(constructor_template, tpl);
+  target->Set(NanNew<String>("CancelToken"), tpl->GetFunction());
+}
+
+NAN_METHOD(CancelToken::JSNewFunction) {
+  NanScope();
+
+  CancelToken *object = new CancelToken();
+  object->Wrap(args.This());
+
+  NanReturnValue(args.This());
+}
+
+CancelToken *CancelToken::FromValue(Handle<v8::Value> value) {
+  if (!value->IsObject() || !NanNew(constructor_template)->HasInstance(value)) {
+    return NULL;
+  }
+
+  return ObjectWrap::Unwrap<CancelToken>(value->ToObject());
+}
+
+bool CancelToken::IsCancelled() {
+  uv_mutex_lock(&this->mutex);
+  bool cancelled = this->cancelled;
+  uv_mutex_unlock(&this->mutex);
+
+  return cancelled;
+}
+
+NAN_METHOD(CancelToken::Cancel) {
+  NanScope();
+
+  CancelToken *token = ObjectWrap::Unwrap<CancelToken>(args.This());
+
+  uv_mutex_lock(&token->mutex);
+  token->cancelled = true;
+  uv_mutex_unlock(&token->mutex);
+
+  NanReturnUndefined();
+}
+
+NAN_METHOD(CancelToken::JSIsCancelled) {
+  NanScope();
+
+  NanReturnValue(NanNew<Boolean>(
+    ObjectWrap::Unwrap<CancelToken>(args.This())->IsCancelled()
+  ));
+}
+
+void CancelToken::SetCurrent(CancelToken *token) {
+  uv_key_set(&current, token);
+}
+
+bool CancelToken::IsCurrentCancelled() {
+  CancelToken *token = static_cast<CancelToken *>(uv_key_get(&current));
+
+  return token != NULL && token->IsCancelled();
+}
+
+void CancelToken::SetCancelledError() {
+  giterr_set_str(GITERR_CALLBACK, "The operation was cancelled.");
+}
+
+Persistent<FunctionTemplate> CancelToken::constructor_template;
+uv_key_t CancelToken::current;
@@ -0,0 +1,822 @@
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "../include/commit_graph.h"
+
+static const char MAGIC[4] = { 'N', 'G', 'C', 'G' };
+static const uint32_t VERSION = 1;
+static const uint32_t BYTE_ORDER = 0x01020304;
+static const char FILE_NAME[] = "nodegit-commit-graph";
+
+uv_mutex_t CommitGraph::mutex;
+
+// The graph last loaded for each path, holding a reference of its own.
+static std::map<std::string, CommitGraph *> loaded;
+
+struct OidLess {
+  bool operator()(const git_oid &a, const git_oid &b) const {
+    return git_oid_cmp(&a, &b) < 0;
+  }
+};
+
+void CommitGraph::Initialize() {
+  uv_mutex_init(&mutex);
+}
+
+CommitGraph::CommitGraph()
+  : header(NULL), ids(NULL), commits(NULL), extraParents(NULL), data(NULL),
+    size(0), mapped(false), fileTime(0), fileSize(0), fileId(0),
+    references(0) {
+}
+
+CommitGraph::~CommitGraph() {
+#ifndef _WIN32
+  if (mapped) {
+    munmap(data, size);
+    return;
+  }
+#endif
+  free(data);
+}
+
+std::string CommitGraph::PathFor(git_repository *repo) {
+  return std::string(git_repository_path(repo)) + FILE_NAME;
+}
+
+static bool Identify(const struct stat &info, uint64_t *time, uint64_t *size,
+    uint64_t *id) {
+  *time = (uint64_t)info.st_mtime;
+  *size = (uint64_t)info.st_size;
+  *id = (uint64_t)info.st_ino;
+  return true;
+}
+
+CommitGraph *CommitGraph::Load(const std::string &path) {
+  CommitGraph *graph = new CommitGraph();
+  struct stat info;
+
+  graph->path = path;
+
+#ifdef _WIN32
+  FILE *file = fopen(path.c_str(), "rb");
+
+  if (file != NULL && fstat(_fileno(file), &info) == 0) {
+    graph->size = (size_t)info.st_size;
+    graph->data = malloc(graph->size ? graph->size : 1);
+
+    if (fread(graph->data, 1, graph->size, file) != graph->size) {
+      graph->size = 0;
+    }
+  }
+
+  if (file != NULL) {
+    fclose(file);
+  }
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+
+  if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0) {
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data != MAP_FAILED) {
+      graph->data = data;
+      graph->size = (size_t)info.st_size;
+      graph->mapped = true;
+    }
+  }
+
+  if (fd >= 0) {
+    close(fd);
+  }
+#endif
+
+  const Header *header = (const Header *)graph->data;
+
+  if (graph->size < sizeof(Header)
+      || memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+      || header->version != VERSION
+      || header->byteOrder != BYTE_ORDER
+      || header->fanout[255] != header->count
+      || graph->size != sizeof(Header)
+        + (uint64_t)header->count * (sizeof(git_oid) + sizeof(Commit))
+        + (uint64_t)header->extraCount * sizeof(uint32_t)) {
+    delete graph;
+    return NULL;
+  }
+
+  // Find narrows its search with the fanout, so it has to stay within the ids
+  // and never go back down.
+  for (int i = 0; i < 256; i++) {
+    if (header->fanout[i] > header->count
+        || (i > 0 && header->fanout[i] < header->fanout[i - 1])) {
+      delete graph;
+      return NULL;
+    }
+  }
+
+  Identify(info, &graph->fileTime, &graph->fileSize, &graph->fileId);
+
+  graph->header = header;
+  graph->ids = (const git_oid *)(header + 1);
+  graph->commits = (const Commit *)(graph->ids + header->count);
+  graph->extraParents = (const uint32_t *)(graph->commits + header->count);
+
+  return graph;
+}
+
+CommitGraph *CommitGraph::Acquire(git_repository *repo) {
+  std::string path = PathFor(repo);
+  CommitGraph *graph = NULL;
+  uint64_t time, size, id;
+  struct stat info;
+  bool exists = stat(path.c_str(), &info) == 0
+    && Identify(info, &time, &size, &id);
+
+  uv_mutex_lock(&mutex);
+
+  std::map<std::string, CommitGraph *>::iterator cached = loaded.find(path);
+
+  if (cached != loaded.end()) {
+    CommitGraph *previous = cached->second;
+
+    if (exists && previous->fileTime == time && previous->fileSize == size
+        && previous->fileId == id) {
+      graph = previous;
+    }
+    else {
+      loaded.erase(cached);
+
+      if (--previous->references == 0) {
+        delete previous;
+      }
+    }
+  }
+
+  if (graph == NULL && exists && (graph = Load(path)) != NULL) {
+    graph->references = 1;
+    loaded[path] = graph;
+  }
+
+  if (graph != NULL) {
+    graph->references++;
+  }
+
+  uv_mutex_unlock(&mutex);
+
+  return graph;
+}
+
+void CommitGraph::Release() {
+  uv_mutex_lock(&mutex);
+
+  if (--references == 0) {
+    delete this;
+  }
+
+  uv_mutex_unlock(&mutex);
+}
+
+bool CommitGraph::Find(const git_oid *id, uint32_t *position) const {
+  uint8_t first = id->id[0];
+  uint32_t low = first ? header->fanout[first - 1] : 0;
+  uint32_t high = header->fanout[first];
+
+  while (low < high) {
+    uint32_t middle = low + (high - low) / 2;
+    int comparison = git_oid_cmp(id, &ids[middle]);
+
+    if (comparison == 0) {
+      *position = middle;
+      return true;
+    }
+
+    if (comparison < 0) {
+      high = middle;
+    }
+    else {
+      low = middle + 1;
+    }
+  }
+
+  return false;
+}
+
+void CommitGraph::Parents(uint32_t position, std::vector<uint32_t> *out)
+    const {
+  const Commit &commit = commits[position];
+
+  out->clear();
+
+  if (commit.parents[0] == NO_PARENT) {
+    return;
+  }
+
+  out->push_back(commit.parents[0]);
+
+  if (commit.parents[1] == NO_PARENT) {
+    return;
+  }
+
+  if (!(commit.parents[1] & EXTRA_PARENTS)) {
+    out->push_back(commit.parents[1]);
+    return;
+  }
+
+  for (uint32_t i = commit.parents[1] & ~EXTRA_PARENTS;
+      i < header->extraCount; i++) {
+    out->push_back(extraParents[i] & ~EXTRA_PARENTS);
+
+    if (extraParents[i] & EXTRA_PARENTS) {
+      break;
+    }
+  }
+
+  // A damaged file mustn't send us outside of it.
+  for (size_t i = 0; i < out->size(); i++) {
+    if ((*out)[i] >= header->count) {
+      out->clear();
+      return;
+    }
+  }
+}
+
+namespace {
+  enum {
+    ONE = 1,
+    TWO = 2,
+    BOTH = ONE | TWO,
+    QUEUED = 4
+  };
+}
+
+struct CommitGraph::Painter {
+  typedef std::pair<uint32_t, uint32_t> Entry;
+
+  Painter(const Commit *commits, uint32_t count)
+    : commits(commits), flags(count, 0), interesting(0) {
+  }
+
+  // Only the commits the last walk touched are cleared, so one painter can
+  // be reused for any number of walks.
+  void Reset() {
+    for (size_t i = 0; i < touched.size(); i++) {
+      flags[touched[i]] = 0;
+    }
+
+    touched.clear();
+    queue = std::priority_queue<Entry>();
+    interesting = 0;
+  }
+
+  void Mark(uint32_t position, uint8_t side) {
+    uint8_t before = flags[position];
+    uint8_t mark = before | side;
+
+    if (mark == before) {
+      return;
+    }
+
+    if (before == 0) {
+      touched.push_back(position);
+    }
+
+    if (!(before & QUEUED)) {
+      mark |= QUEUED;
+      queue.push(Entry(commits[position].generation, position));
+
+      if ((mark & BOTH) != BOTH) {
+        interesting++;
+      }
+    }
+    else if ((before & BOTH) != BOTH && (mark & BOTH) == BOTH) {
+      interesting--;
+    }
+
+    flags[position] = mark;
+  }
+
+  uint8_t Pop(uint32_t *position) {
+    *position = queue.top().second;
+    queue.pop();
+
+    uint8_t mark = flags[*position] & ~QUEUED;
+
+    flags[*position] = mark;
+
+    if ((mark & BOTH) != BOTH) {
+      interesting--;
+    }
+
+    return mark;
+  }
+
+  const Commit *commits;
+  std::vector<uint8_t> flags;
+  std::vector<uint32_t> touched;
+  std::vector<uint32_t> parents;
+  std::priority_queue<Entry> queue;
+  // Queued commits that only one side reaches so far.
+  size_t interesting;
+};
+
+bool CommitGraph::Paint(Painter &painter, uint32_t one, uint32_t two,
+    size_t *onlyOne, size_t *onlyTwo, uint32_t *common) const {
+  uint32_t position;
+  bool found = false;
+
+  painter.Reset();
+
+  if (onlyOne != NULL) {
+    *onlyOne = 0;
+    *onlyTwo = 0;
+  }
+
+  painter.Mark(one, ONE);
+  painter.Mark(two, TWO);
+
+  // Every commit is popped after all of its descendants, so its marks are
+  // final by then. Once nothing queued is interesting, everything left
+  // would be reached by both sides.
+  while (!painter.queue.empty()
+      && ((onlyOne != NULL && painter.interesting > 0)
+        || (common != NULL && !found))) {
+    uint8_t side = painter.Pop(&position);
+
+    if (side == BOTH) {
+      if (common != NULL && !found) {
+        *common = position;
+        found = true;
+      }
+    }
+    else if (onlyOne != NULL) {
+      (*(side == ONE ? onlyOne : onlyTwo))++;
+    }
+
+    Parents(position, &painter.parents);
+
+    for (size_t i = 0; i < painter.parents.size(); i++) {
+      painter.Mark(painter.parents[i], side);
+    }
+  }
+
+  return found;
+}
+
+int CommitGraph::AheadBehind(size_t *ahead, size_t *behind,
+    const git_oid *local, const git_oid *upstream) const {
+  uint32_t one, two;
+
+  if (!Find(local, &one) || !Find(upstream, &two)) {
+    return GIT_PASSTHROUGH;
+  }
+
+  Painter painter(commits, header->count);
+
+  Paint(painter, one, two, ahead, behind, NULL);
+
+  return GIT_OK;
+}
+
+int CommitGraph::MergeBase(git_oid *out, const git_oid *one,
+    const git_oid *two) const {
+  uint32_t first, second, base;
+
+  if (!Find(one, &first) || !Find(two, &second)) {
+    return GIT_PASSTHROUGH;
+  }
+
+  Painter painter(commits, header->count);
+
+  if (!Paint(painter, first, second, NULL, NULL, &base)) {
+    giterr_set_str(GITERR_MERGE, "No merge base found");
+    return GIT_ENOTFOUND;
+  }
+
+  git_oid_cpy(out, &ids[base]);
+
+  return GIT_OK;
+}
+
+int CommitGraph::AheadBehindMany(git_repository *repo, const git_oid *base,
+    const git_oid *tips, size_t count, size_t *ahead, size_t *behind,
+    git_oid *bases) {
+  CommitGraph *graph = Acquire(repo);
+  uint32_t from = 0;
+  bool known = graph != NULL && graph->Find(base, &from);
+  Painter painter(known ? graph->commits : NULL,
+    known ? graph->header->count : 0);
+  int error = GIT_OK;
+
+  for (size_t i = 0; i < count && error == GIT_OK; i++) {
+    uint32_t to, common;
+
+    if (known && graph->Find(&tips[i], &to)) {
+      bool found = graph->Paint(painter, to, from, &ahead[i], &behind[i],
+        bases != NULL ? &common : NULL);
+
+      if (bases != NULL && found) {
+        git_oid_cpy(&bases[i], &graph->ids[common]);
+      }
+      else if (bases != NULL) {
+        memset(&bases[i], 0, sizeof(git_oid));
+      }
+
+      continue;
+    }
+
+    error = git_graph_ahead_behind(&ahead[i], &behind[i], repo, &tips[i],
+      base);
+
+    if (error == GIT_OK && bases != NULL) {
+      error = git_merge_base(&bases[i], repo, &tips[i], base);
+
+      if (error == GIT_ENOTFOUND) {
+        memset(&bases[i], 0, sizeof(git_oid));
+        giterr_clear();
+        error = GIT_OK;
+      }
+    }
+  }
+
+  if (graph != NULL) {
+    graph->Release();
+  }
+
+  return error;
+}
+
+int CommitGraph::HideKnown(const git_oid *id, void *payload) {
+  uint32_t position;
+
+  return ((const CommitGraph *)payload)->Find(id, &position);
+}
+
+// Pushes every commit a ref or HEAD points at, skipping refs that don't
+// lead to a commit.
+static int PushTips(git_revwalk *walk, git_repository *repo) {
+  git_reference_iterator *iterator = NULL;
+  git_reference *reference = NULL;
+  git_object *tip = NULL;
+  git_oid head;
+  int error = git_reference_iterator_new(&iterator, repo);
+
+  while (error == GIT_OK
+      && (error = git_reference_next(&reference, iterator)) == GIT_OK) {
+    if (git_reference_peel(&tip, reference, GIT_OBJ_COMMIT) == GIT_OK) {
+      error = git_revwalk_push(walk, git_object_id(tip));
+      git_object_free(tip);
+    }
+
+    git_reference_free(reference);
+  }
+
+  git_reference_iterator_free(iterator);
+
+  if (error != GIT_ITEROVER) {
+    return error;
+  }
+
+  if (git_reference_name_to_id(&head, repo, "HEAD") == GIT_OK) {
+    git_revwalk_push(walk, &head);
+  }
+
+  giterr_clear();
+
+  return GIT_OK;
+}
+
+// Returns GIT_ELOCKED when another writer holds the lock file.
+static int WriteFile(const std::string &path,
+    const CommitGraph::Header &header, const std::vector<git_oid> &ids,
+    const std::vector<CommitGraph::Commit> &commits,
+    const std::vector<uint32_t> &extraParents) {
+  std::string lockPath = path + ".lock";
+#ifdef _WIN32
+  int fd = _open(lockPath.c_str(), _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY,
+    _S_IREAD | _S_IWRITE);
+  FILE *file = fd >= 0 ? _fdopen(fd, "wb") : NULL;
+#else
+  int fd = open(lockPath.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+  FILE *file = fd >= 0 ? fdopen(fd, "wb") : NULL;
+#endif
+
+  if (fd < 0) {
+    if (errno == EEXIST) {
+      giterr_set_str(GITERR_OS, "The commit graph is locked by another writer");
+      return GIT_ELOCKED;
+    }
+
+    giterr_set_str(GITERR_OS, "Failed to write the commit graph");
+    return GIT_ERROR;
+  }
+
+  if (file == NULL) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    close(fd);
+#endif
+    remove(lockPath.c_str());
+    giterr_set_str(GITERR_OS, "Failed to write the commit graph");
+    return GIT_ERROR;
+  }
+
+  bool written = fwrite(&header, sizeof(header), 1, file) == 1
+    && (ids.empty()
+      || fwrite(&ids[0], sizeof(git_oid), ids.size(), file) == ids.size())
+    && (commits.empty()
+      || fwrite(&commits[0], sizeof(CommitGraph::Commit), commits.size(),
+        file) == commits.size())
+    && (extraParents.empty()
+      || fwrite(&extraParents[0], sizeof(uint32_t), extraParents.size(),
+        file) == extraParents.size());
+
+  written = fclose(file) == 0 && written;
+
+#ifdef _WIN32
+  written = written && MoveFileExA(lockPath.c_str(), path.c_str(),
+    MOVEFILE_REPLACE_EXISTING);
+#else
+  written = written && rename(lockPath.c_str(), path.c_str()) == 0;
+#endif
+
+  if (!written) {
+    remove(lockPath.c_str());
+    giterr_set_str(GITERR_OS, "Failed to write the commit graph");
+    return GIT_ERROR;
+  }
+
+  return GIT_OK;
+}
+
+namespace {
+  struct NewCommit {
+    git_oid id;
+    std::vector<git_oid> parents;
+    int64_t time;
+    uint32_t generation;
+
+    bool operator<(const NewCommit &other) const {
+      return git_oid_cmp(&id, &other.id) < 0;
+    }
+  };
+}
+
+int CommitGraph::Write(git_repository *repo, const CommitGraph *old) {
+  git_revwalk *walk = NULL;
+  git_commit *commit = NULL;
+  std::vector<NewCommit> added;
+  std::map<git_oid, uint32_t, OidLess> generations;
+  git_oid id;
+  int error = git_revwalk_new(&walk, repo);
+
+  if (error != GIT_OK) {
+    return error;
+  }
+
+  // Parents come out before their children, so their generations are
+  // known by the time a child needs them.
+  git_revwalk_sorting(walk, GIT_SORT_TOPOLOGICAL | GIT_SORT_REVERSE);
+
+  if (old != NULL) {
+    error = git_revwalk_add_hide_cb(walk, HideKnown, (void *)old);
+  }
+
+  if (error == GIT_OK) {
+    error = PushTips(walk, repo);
+  }
+
+  while (error == GIT_OK && (error = git_revwalk_next(&id, walk)) == GIT_OK) {
+    NewCommit entry;
+    uint32_t generation = 0;
+
+    if ((error = git_commit_lookup(&commit, repo, &id)) != GIT_OK) {
+      break;
+    }
+
+    git_oid_cpy(&entry.id, &id);
+    entry.time = (int64_t)git_commit_time(commit);
+
+    for (unsigned int i = 0; i < git_commit_parentcount(commit); i++) {
+      const git_oid *parent = git_commit_parent_id(commit, i);
+      std::map<git_oid, uint32_t, OidLess>::iterator known =
+        generations.find(*parent);
+      uint32_t position;
+
+      if (known != generations.end()) {
+        generation = std::max(generation, known->second);
+      }
+      else if (old != NULL && old->Find(parent, &position)) {
+        generation = std::max(generation, old->commits[position].generation);
+      }
+      else {
+        // Only a graph that lost track of the refs gets here.
+        giterr_set_str(GITERR_INVALID, "The commit graph is missing a parent");
+        error = old != NULL ? GIT_PASSTHROUGH : GIT_ENOTFOUND;
+        break;
+      }
+
+      entry.parents.push_back(*parent);
+    }
+
+    git_commit_free(commit);
+
+    entry.generation = generation + 1;
+    generations[entry.id] = entry.generation;
+    added.push_back(entry);
+  }
+
+  git_revwalk_free(walk);
+
+  if (error != GIT_ITEROVER) {
+    return error;
+  }
+
+  giterr_clear();
+
+  if (added.empty() && old != NULL) {
+    return GIT_OK;
+  }
+
+  std::sort(added.begin(), added.end());
+
+  uint32_t oldCount = old != NULL ? old->header->count : 0;
+  size_t count = oldCount + added.size();
+
+  if (count >= EXTRA_PARENTS) {
+    giterr_set_str(GITERR_INVALID, "Too many commits for the commit graph");
+    return GIT_ERROR;
+  }
+
+  // Merge the old commits and the new ones into one sorted table, noting
+  // where each came from.
+  std::vector<git_oid> allIds;
+  std::vector<uint32_t> sources;
+  std::vector<bool> fromOld;
+  uint32_t nextOld = 0;
+  size_t nextNew = 0;
+
+  allIds.reserve(count);
+  sources.reserve(count);
+  fromOld.reserve(count);
+
+  while (nextOld < oldCount || nextNew < added.size()) {
+    bool takeOld = nextNew == added.size() || (nextOld < oldCount
+      && git_oid_cmp(&old->ids[nextOld], &added[nextNew].id) < 0);
+
+    if (takeOld) {
+      allIds.push_back(old->ids[nextOld]);
+      sources.push_back(nextOld++);
+    }
+    else {
+      allIds.push_back(added[nextNew].id);
+      sources.push_back((uint32_t)nextNew++);
+    }
+
+    fromOld.push_back(takeOld);
+  }
+
+  Header header;
+  std::vector<Commit> allCommits(count);
+  std::vector<uint32_t> extraParents;
+  std::vector<uint32_t> oldParents;
+  std::vector<uint32_t> parents;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrder = BYTE_ORDER;
+  header.count = (uint32_t)count;
+
+  for (size_t i = 0; i < count; i++) {
+    header.fanout[allIds[i].id[0]]++;
+  }
+  for (int i = 1; i < 256; i++) {
+    header.fanout[i] += header.fanout[i - 1];
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    Commit &entry = allCommits[i];
+    uint64_t time;
+
+    parents.clear();
+
+    if (fromOld[i]) {
+      const Commit &previous = old->commits[sources[i]];
+
+      old->Parents(sources[i], &oldParents);
+
+      for (size_t j = 0; j < oldParents.size(); j++) {
+        parents.push_back((uint32_t)(std::lower_bound(allIds.begin(),
+          allIds.end(), old->ids[oldParents[j]], OidLess()) - allIds.begin()));
+      }
+
+      entry.generation = previous.generation;
+      time = (uint64_t)previous.timeHigh << 32 | previous.timeLow;
+    }
+    else {
+      const NewCommit &commit = added[sources[i]];
+
+      for (size_t j = 0; j < commit.parents.size(); j++) {
+        parents.push_back((uint32_t)(std::lower_bound(allIds.begin(),
+          allIds.end(), commit.parents[j], OidLess()) - allIds.begin()));
+      }
+
+      entry.generation = commit.generation;
+      time = (uint64_t)commit.time;
+    }
+
+    entry.timeLow = (uint32_t)time;
+    entry.timeHigh = (uint32_t)(time >> 32);
+    entry.parents[0] = parents.size() > 0 ? parents[0] : NO_PARENT;
+    entry.parents[1] = parents.size() > 1 ? parents[1] : NO_PARENT;
+
+    if (parents.size() > 2) {
+      entry.parents[1] = EXTRA_PARENTS | (uint32_t)extraParents.size();
+      extraParents.insert(extraParents.end(), parents.begin() + 1,
+        parents.end());
+      extraParents.back() |= EXTRA_PARENTS;
+    }
+  }
+
+  header.extraCount = (uint32_t)extraParents.size();
+
+  return WriteFile(PathFor(repo), header, allIds, allCommits, extraParents);
+}
+
+int CommitGraph::Update(git_repository *repo) {
+  CommitGraph *old = Acquire(repo);
+  int error = Write(repo, old);
+
+  if (old != NULL) {
+    old->Release();
+  }
+
+  // The old graph can't be extended, so start over without it.
+  if (error == GIT_PASSTHROUGH) {
+    error = Write(repo, NULL);
+  }
+
+  return error;
+}
+
+extern "C" {
+  int nodegit_graph_ahead_behind(size_t *ahead, size_t *behind,
+      git_repository *repo, const git_oid *local, const git_oid *upstream) {
+    CommitGraph *graph = CommitGraph::Acquire(repo);
+    int error = GIT_PASSTHROUGH;
+
+    if (graph != NULL) {
+      error = graph->AheadBehind(ahead, behind, local, upstream);
+      graph->Release();
+    }
+
+    if (error == GIT_PASSTHROUGH) {
+      error = git_graph_ahead_behind(ahead, behind, repo, local, upstream);
+    }
+
+    return error;
+  }
+
+  int nodegit_merge_base(git_oid *out, git_repository *repo,
+      const git_oid *one, const git_oid *two) {
+    CommitGraph *graph = CommitGraph::Acquire(repo);
+    int error = GIT_PASSTHROUGH;
+
+    if (graph != NULL) {
+      error = graph->MergeBase(out, one, two);
+      graph->Release();
+    }
+
+    if (error == GIT_PASSTHROUGH) {
+      error = git_merge_base(out, repo, one, two);
+    }
+
+    return error;
+  }
+
+  int nodegit_graph_ahead_behind_many(size_t *ahead, size_t *behind,
+      git_oid *bases, git_repository *repo, const git_oid *base,
+      const git_oid *tips, size_t count) {
+    return CommitGraph::AheadBehindMany(repo, base, tips, count, ahead,
+      behind, bases);
+  }
+
+  int nodegit_graph_write_commit_graph(git_repository *repo) {
+    return CommitGraph::Update(repo);
+  }
+}
@@ -0,0 +1,157 @@
+#include <ctype.h>
+#include <nan.h>
+#include <node_buffer.h>
+#include <string.h>
+
+#include "../include/commit_metadata.h"
+
+using namespace v8;
+
+int CommitMetadata::Read(git_repository *repo, const git_oid *id) {
+  git_commit *commit = NULL;
+  int error = git_commit_lookup(&commit, repo, id);
+
+  if (error != GIT_OK) {
+    return error;
+  }
+
+  entries.push_back(Entry());
+  Entry &entry = entries.back();
+
+  git_oid_cpy(&entry.id, id);
+
+  unsigned int parentCount = git_commit_parentcount(commit);
+  entry.parents.resize(parentCount);
+  for (unsigned int i = 0; i < parentCount; i++) {
+    git_oid_cpy(&entry.parents[i], git_commit_parent_id(commit, i));
+  }
+
+  CopyPerson(&entry.author, git_commit_author(commit));
+  CopyPerson(&entry.committer, git_commit_committer(commit));
+  CopySummary(&entry.summary, git_commit_message(commit));
+
+  git_commit_free(commit);
+
+  return GIT_OK;
+}
+
+void CommitMetadata::CopyPerson(Person *to, const git_signature *from) {
+  to->name = from->name ? from->name : "";
+  to->email = from->email ? from->email : "";
+  to->time = from->when.time;
+  to->offset = from->when.offset;
+}
+
+// The same as git_commit_summary, which can't be used here because it
+// caches its result on the shared commit: the first paragraph, with every
+// run of whitespace that spans a line break folded into a single space.
+void CommitMetadata::CopySummary(std::string *to, const char *message) {
+  const char *space = NULL;
+
+  to->clear();
+
+  for (const char *at = message ? message : ""; *at; at++) {
+    if (*at == '\n' && (!at[1] || at[1] == '\n')) {
+      break;
+    }
+    else if (isspace((unsigned char)*at)) {
+      if (space == NULL) {
+        space = at;
+      }
+    }
+    else {
+      if (space) {
+        if (memchr(space, '\n', at - space)) {
+          to->push_back(' ');
+        }
+        else {
+          to->append(space, at - space);
+        }
+        space = NULL;
+      }
+
+      to->push_back(*at);
+    }
+  }
+}
+
+static Local<String> StringOf(const std::string &value) {
+  return NanNew<String>(value.data(), (int)value.size());
+}
+
+/*
+ * {
+ *   count: Number,
+ *   ids: Buffer of packed oids,
+ *   parentCounts: [Number], parents: Buffer of every commit's parents, packed
+ *   authorNames, authorEmails, authorTimes, authorOffsets,
+ *   committerNames, committerEmails, committerTimes, committerOffsets,
+ *   summaries
+ * }
+ *
+ * Every array has an entry per commit, in the order they were read.
+ */
+Handle<Object> CommitMetadata::ToColumns() const {
+  NanEscapableScope();
+
+  uint32_t count = (uint32_t)entries.size();
+  size_t parentTotal = 0;
+
+  for (uint32_t i = 0; i < count; i++) {
+    parentTotal += entries[i].parents.size();
+  }
+
+  Local<Object> ids = NanNewBufferHandle(count * GIT_OID_RAWSZ);
+  Local<Object> parents = NanNewBufferHandle((uint32_t)(parentTotal * GIT_OID_RAWSZ));
+  git_oid *idData = (git_oid *)node::Buffer::Data(ids);
+  git_oid *parentData = (git_oid *)node::Buffer::Data(parents);
+
+  Local<Array> parentCounts = NanNew<Array>(count);
+  Local<Array> authorNames = NanNew<Array>(count);
+  Local<Array> authorEmails = NanNew<Array>(count);
+  Local<Array> authorTimes = NanNew<Array>(count);
+  Local<Array> authorOffsets = NanNew<Array>(count);
+  Local<Array> committerNames = NanNew<Array>(count);
+  Local<Array> committerEmails = NanNew<Array>(count);
+  Local<Array> committerTimes = NanNew<Array>(count);
+  Local<Array> committerOffsets = NanNew<Array>(count);
+  Local<Array> summaries = NanNew<Array>(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    const Entry &entry = entries[i];
+
+    idData[i] = entry.id;
+    for (size_t j = 0; j < entry.parents.size(); j++) {
+      *parentData++ = entry.parents[j];
+    }
+
+    parentCounts->Set(i, NanNew<Number>((double)entry.parents.size()));
+    authorNames->Set(i, StringOf(entry.author.name));
+    authorEmails->Set(i, StringOf(entry.author.email));
+    authorTimes->Set(i, NanNew<Number>((double)entry.author.time));
+    authorOffsets->Set(i, NanNew<Number>(entry.author.offset));
+    committerNames->Set(i, StringOf(entry.committer.name));
+    committerEmails->Set(i, StringOf(entry.committer.email));
+    committerTimes->Set(i, NanNew<Number>((double)entry.committer.time));
+    committerOffsets->Set(i, NanNew<Number>(entry.committer.offset));
+    summaries->Set(i, StringOf(entry.summary));
+  }
+
+  Local<Object> result = NanNew<Object>();
+
+  result->Set(NanNew<String>("count"), NanNew<Number>(count));
+  result->Set(NanNew<String>("ids"), ids);
+  result->Set(NanNew<String>("parentCounts"), parentCounts);
+  result->Set(NanNew<String>("parents"), parents);
+  result->Set(NanNew<String>("authorNames"), authorNames);
+  result->Set(NanNew<String>("authorEmails"), authorEmails);
+  result->Set(NanNew<String>("authorTimes"), authorTimes);
+  result->Set(NanNew<String>("authorOffsets"), authorOffsets);
+  result->Set(NanNew<String>("committerNames"), committerNames);
+  result->Set(NanNew<String>("committerEmails"), committerEmails);
+  result->Set(NanNew<String>("committerTimes"), committerTimes);
+  result->Set(NanNew<String>("committerOffsets"), committerOffsets);
+  result->Set(NanNew<String>("summaries"), summaries);
+
+  return NanEscapeScope(result);
+}
@@ -0,0 +1,99 @@
+#include <nan.h>
+
+extern "C" {
+  #include <git2.h>
+}
+
+#include "../include/footprint.h"
+
+using namespace v8;
+
+// What an entry costs beyond what libgit2 reports: the struct, its path and
+// the allocator's bookkeeping. Close enough to keep V8 honest.
+static const int64_t ENTRY_OVERHEAD = 64;
+
+int64_t Footprint::Of(const git_blob *blob) {
+  return (int64_t)git_blob_rawsize(blob);
+}
+
+int64_t Footprint::Of(const git_tree *tree) {
+  return (int64_t)git_tree_entrycount(tree) * ENTRY_OVERHEAD;
+}
+
+int64_t Footprint::Of(const git_diff *diff) {
+  return (int64_t)git_diff_num_deltas(diff)
+    * ((int64_t)sizeof(git_diff_delta) + ENTRY_OVERHEAD);
+}
+
+int64_t Footprint::Of(const git_patch *patch) {
+  return (int64_t)git_patch_size((git_patch *)patch, 1, 1, 1)
+    + (int64_t)git_patch_num_hunks(patch) * (int64_t)sizeof(git_diff_hunk);
+}
+
+int64_t Footprint::Of(const git_index *index) {
+  return (int64_t)git_index_entrycount(index)
+    * ((int64_t)sizeof(git_index_entry) + ENTRY_OVERHEAD);
+}
+
+int64_t Footprint::Of(const git_odb_object *object) {
+  return (int64_t)git_odb_object_size((git_odb_object *)object);
+}
+
+int64_t Footprint::Of(const git_buf *buf) {
+  return (int64_t)buf->asize;
+}
+
+void Footprint::InitializeComponent(Handle<v8::Object> target) {
+  NanScope();
+
+  Local<Object> object = NanNew<Object>();
+
+  NODE_SET_METHOD(object, "get", Get);
+
+  target->Set(NanNew<String>("Footprint"), object);
+}
+
+Footprint::Type *Footprint::Register(const char *name) {
+  Type *type = new Type();
+
+  type->name = name;
+  type->live = 0;
+  type->created = 0;
+  type->bytes = 0;
+
+  Types().push_back(type);
+
+  return type;
+}
+
+std::vector<Footprint::Type *> &Footprint::Types() {
+  static std::vector<Type *> types;
+  return types;
+}
+
+// Only types that have had a wrapper show up. `bytes` is the part of the
+// native memory that V8 has been told about.
+NAN_METHOD(Footprint::Get) {
+  NanScope();
+
+  std::vector<Type *> &types = Types();
+  Local<Object> result = NanNew<Object>();
+
+  for (size_t i = 0; i < types.size(); i++) {
+    Type *type = types[i];
+
+    if (type->created == 0) {
+      continue;
+    }
+
+    Local<Object> entry = NanNew<Object>();
+
+    entry->Set(NanNew<String>("live"), NanNew<Number>(type->live));
+    entry->Set(NanNew<String>("created"), NanNew<Number>(type->created));
+    entry->Set(NanNew<String>("bytes"), NanNew<Number>(type->bytes));
+
+    result->Set(NanNew<String>(type->name), entry);
+  }
+
+  NanReturnValue(result);
+}
@@ -9,3 +9,45 @@ const git_error *git_error_dup(const git_error *arg) {
   result->message = strdup(arg->message);
   return result;
 }
+
+// The copies below are a single allocation each, with what they point to
+// after the struct, so they are released with one free().
+
+static size_t path_size(const char *path) {
+  return path == NULL ? 0 : strlen(path) + 1;
+}
+
+static const char *copy_path(char **to, const char *path) {
+  if (path == NULL) {
+    return NULL;
+  }
+
+  size_t size = strlen(path) + 1;
+  const char *copy = (const char *)memcpy(*to, path, size);
+  *to += size;
+  return copy;
+}
+
+const git_diff_delta *git_diff_delta_dup(const git_diff_delta *arg) {
+  git_diff_delta *result = (git_diff_delta *)malloc(sizeof(git_diff_delta)
+    + path_size(arg->old_file.path) + path_size(arg->new_file.path));
+  char *paths = (char *)(result + 1);
+
+  *result = *arg;
+  result->old_file.path = copy_path(&paths, arg->old_file.path);
+  result->new_file.path = copy_path(&paths, arg->new_file.path);
+  return result;
+}
+
+const git_diff_line *git_diff_line_dup(const git_diff_line *arg) {
+  git_diff_line *result = (git_diff_line *)malloc(sizeof(git_diff_line)
+    + arg->content_len);
+  char *content = (char *)(result + 1);
+
+  *result = *arg;
+  if (arg->content != NULL) {
+    memcpy(content, arg->content, arg->content_len);
+    result->content = content;
+  }
+  return result;
+}
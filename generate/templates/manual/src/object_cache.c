@@ -0,0 +1,33 @@
+/*
+ * Built as part of the libgit2 target (see vendor/libgit2.gyp), because it
+ * reads the repository's object cache through libgit2's private headers.
+ */
+#include "common.h"
+#include "cache.h"
+#include "object.h"
+#include "repository.h"
+
+#include "../include/object_cache.h"
+
+int nodegit_object_cache_lookup(
+	git_object **out,
+	git_repository *repo,
+	const git_oid *id,
+	git_otype type)
+{
+	/* Raw odb objects would still have to be parsed, so they don't count. */
+	git_cached_obj *cached = git_cache_get_parsed(&repo->objects, id);
+
+	*out = NULL;
+
+	if (cached == NULL)
+		return GIT_ENOTFOUND;
+
+	if (type != GIT_OBJ_ANY && type != cached->type) {
+		git_object_free((git_object *)cached);
+		return GIT_ENOTFOUND;
+	}
+
+	*out = (git_object *)cached;
+	return 0;
+}
@@ -0,0 +1,235 @@
+#include <nan.h>
+#include <string.h>
+
+#include "../include/path_history.h"
+
+using namespace v8;
+
+PathHistory::PathHistory(const char *path, bool followRenames)
+  : followRenames(followRenames) {
+  SetPath(path);
+}
+
+void PathHistory::SetPath(const std::string &to) {
+  size_t start = 0;
+
+  path = to;
+  components.clear();
+
+  while (start <= path.size()) {
+    size_t slash = path.find('/', start);
+
+    if (slash == std::string::npos) {
+      slash = path.size();
+    }
+
+    if (slash > start) {
+      components.push_back(path.substr(start, slash - start));
+    }
+
+    start = slash + 1;
+  }
+}
+
+// Finds the entry named component in the tree `id` points at, leaving
+// *found false if there is none or `id` isn't a tree.
+static int Descend(git_repository *repo, git_oid *id, git_filemode_t *mode,
+    bool *found, const std::string &component) {
+  git_tree *tree = NULL;
+
+  if (!*found) {
+    return GIT_OK;
+  }
+
+  *found = false;
+
+  if (*mode != GIT_FILEMODE_TREE) {
+    return GIT_OK;
+  }
+
+  int error = git_tree_lookup(&tree, repo, id);
+
+  if (error != GIT_OK) {
+    return error;
+  }
+
+  const git_tree_entry *entry = git_tree_entry_byname(tree, component.c_str());
+
+  if (entry != NULL) {
+    git_oid_cpy(id, git_tree_entry_id(entry));
+    *mode = git_tree_entry_filemode(entry);
+    *found = true;
+  }
+
+  git_tree_free(tree);
+
+  return GIT_OK;
+}
+
+int PathHistory::Compare(git_repository *repo, const git_oid *tree,
+    const git_oid *parentTree, Change *change) const {
+  git_oid ours;
+  git_oid theirs;
+  git_filemode_t ourMode = GIT_FILEMODE_TREE;
+  git_filemode_t theirMode = GIT_FILEMODE_TREE;
+  bool haveOurs = tree != NULL;
+  bool haveTheirs = parentTree != NULL;
+
+  if (haveOurs) {
+    git_oid_cpy(&ours, tree);
+  }
+  if (haveTheirs) {
+    git_oid_cpy(&theirs, parentTree);
+  }
+
+  for (size_t i = 0; i <= components.size(); i++) {
+    if (!haveOurs && !haveTheirs) {
+      *change = UNCHANGED;
+      return GIT_OK;
+    }
+
+    // A shared subtree means nothing under it changed either.
+    if (haveOurs && haveTheirs && git_oid_equal(&ours, &theirs)
+        && ourMode == theirMode) {
+      *change = UNCHANGED;
+      return GIT_OK;
+    }
+
+    if (i == components.size()) {
+      break;
+    }
+
+    int error = Descend(repo, &ours, &ourMode, &haveOurs, components[i]);
+    if (error == GIT_OK) {
+      error = Descend(repo, &theirs, &theirMode, &haveTheirs, components[i]);
+    }
+    if (error != GIT_OK) {
+      return error;
+    }
+  }
+
+  if (haveOurs && haveTheirs) {
+    *change = MODIFIED;
+  }
+  else if (haveOurs) {
+    *change = ADDED;
+  }
+  else {
+    *change = DELETED;
+  }
+
+  return GIT_OK;
+}
+
+int PathHistory::Differs(git_repository *repo, const git_oid *tree,
+    const git_oid *parentTree, bool *differs) const {
+  Change change = UNCHANGED;
+  int error = Compare(repo, tree, parentTree, &change);
+
+  *differs = change != UNCHANGED;
+
+  return error;
+}
+
+int PathHistory::FindRename(git_repository *repo, git_commit *commit,
+    git_commit *parent) {
+  git_tree *tree = NULL;
+  git_tree *parentTree = NULL;
+  git_diff *diff = NULL;
+  git_diff_find_options findOptions = GIT_DIFF_FIND_OPTIONS_INIT;
+  int error;
+
+  findOptions.flags = GIT_DIFF_FIND_RENAMES;
+
+  if ((error = git_commit_tree(&tree, commit)) != GIT_OK
+      || (error = git_commit_tree(&parentTree, parent)) != GIT_OK
+      || (error = git_diff_tree_to_tree(&diff, repo, parentTree, tree, NULL)) != GIT_OK
+      || (error = git_diff_find_similar(diff, &findOptions)) != GIT_OK) {
+    goto cleanup;
+  }
+
+  for (size_t i = 0; i < git_diff_num_deltas(diff); i++) {
+    const git_diff_delta *delta = git_diff_get_delta(diff, i);
+
+    if (delta->status == GIT_DELTA_RENAMED && path == delta->new_file.path) {
+      SetPath(delta->old_file.path);
+      break;
+    }
+  }
+
+cleanup:
+  git_diff_free(diff);
+  git_tree_free(parentTree);
+  git_tree_free(tree);
+
+  return error;
+}
+
+int PathHistory::Visit(git_repository *repo, const git_oid *id) {
+  git_commit *commit = NULL;
+  git_commit *parent = NULL;
+  Change change = UNCHANGED;
+  unsigned int parentCount;
+  int error = git_commit_lookup(&commit, repo, id);
+
+  if (error != GIT_OK) {
+    return error;
+  }
+
+  parentCount = git_commit_parentcount(commit);
+
+  if (parentCount == 0) {
+    error = Compare(repo, git_commit_tree_id(commit), NULL, &change);
+  }
+
+  for (unsigned int i = 0; i < parentCount; i++) {
+    git_commit_free(parent);
+    parent = NULL;
+
+    if ((error = git_commit_parent(&parent, commit, i)) != GIT_OK) {
+      break;
+    }
+
+    error = Compare(repo, git_commit_tree_id(commit),
+      git_commit_tree_id(parent), &change);
+
+    // Only a change from every parent counts, as for
+    // `git log --full-history`.
+    if (error != GIT_OK || change == UNCHANGED) {
+      break;
+    }
+  }
+
+  if (error == GIT_OK && change != UNCHANGED) {
+    error = commits.Read(repo, id);
+
+    if (error == GIT_OK) {
+      paths.push_back(path);
+
+      if (followRenames && change == ADDED && parentCount == 1) {
+        error = FindRename(repo, commit, parent);
+      }
+    }
+  }
+
+  git_commit_free(parent);
+  git_commit_free(commit);
+
+  return error;
+}
+
+Handle<Object> PathHistory::ToColumns() const {
+  NanEscapableScope();
+
+  Local<Object> result = NanNew(commits.ToColumns());
+  Local<Array> pathColumn = NanNew<Array>((uint32_t)paths.size());
+
+  for (uint32_t i = 0; i < paths.size(); i++) {
+    pathColumn->Set(i, NanNew<String>(paths[i].data(), (int)paths[i].size()));
+  }
+
+  result->Set(NanNew<String>("paths"), pathColumn);
+  result->Set(NanNew<String>("path"), NanNew<String>(path.data(), (int)path.size()));
+
+  return NanEscapeScope(result);
+}
@@ -0,0 +1,119 @@
+#include <nan.h>
+#include <node.h>
+
+#include "../include/promise_factory.h"
+
+using namespace v8;
+using namespace node;
+
+void PromiseFactory::InitializeComponent(Handle<v8::Object> target) {
+  NanScope();
+
+  NanAssignPersistent(pending, NanNew<Array>());
+  NanAssignPersistent(executor, NanNew<FunctionTemplate>(Executor)->GetFunction());
+
+  NODE_SET_METHOD(target, "setPromiseConstructor", SetConstructor);
+}
+
+bool PromiseFactory::IsAvailable() {
+  return !constructor.IsEmpty();
+}
+
+NAN_METHOD(PromiseFactory::SetConstructor) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsFunction()) {
+    return NanThrowError("Promise constructor must be a Function.");
+  }
+
+  NanAssignPersistent(constructor, args[0].As<Function>());
+
+  NanReturnUndefined();
+}
+
+// Promise constructors run their executor straight away, so this happens
+// inside Push.
+NAN_METHOD(PromiseFactory::Executor) {
+  NanScope();
+
+  Local<Array> stack = NanNew(pending);
+  stack->Set(stack->Length(), args[0]);
+  stack->Set(stack->Length(), args[1]);
+
+  NanReturnUndefined();
+}
+
+Local<Object> PromiseFactory::Push() {
+  NanEscapableScope();
+
+  Local<v8::Value> argv[1] = { NanNew(executor) };
+
+  return NanEscapeScope(NanNew(constructor)->NewInstance(1, argv));
+}
+
+// No scope of its own, the handles belong to the caller.
+void PromiseFactory::Pop(Local<Function> *resolve, Local<Function> *reject) {
+  Local<Array> stack = NanNew(pending);
+  uint32_t length = stack->Length();
+
+  *resolve = stack->Get(length - 2).As<Function>();
+  *reject = stack->Get(length - 1).As<Function>();
+
+  stack->Set(NanNew<String>("length"), NanNew<Number>(length - 2));
+}
+
+Local<Function> PromiseFactory::Handler(NanFunctionCallback callback) {
+  Persistent<Function> *&handler = handlers[callback];
+
+  if (handler == NULL) {
+    handler = new Persistent<Function>();
+    NanAssignPersistent(*handler,
+      NanNew<FunctionTemplate>(callback)->GetFunction());
+  }
+
+  return NanNew(*handler);
+}
+
+static Local<v8::Value> Bind(Local<Function> handler, Handle<Object> holder) {
+  Local<Function> bind = handler->Get(NanNew("bind")).As<Function>();
+  Handle<v8::Value> argv[1] = { holder };
+
+  return bind->Call(handler, 1, argv);
+}
+
+void PromiseFactory::Then(Handle<Object> promise, Handle<Function> then,
+    NanFunctionCallback fulfilled, NanFunctionCallback rejected,
+    void *baton) {
+  NanScope();
+
+  Local<Object> holder = NanNew<Object>();
+  holder->SetHiddenValue(NanNew("baton"), NanNew<External>(baton));
+
+  Handle<v8::Value> argv[2] = {
+    Bind(Handler(fulfilled), holder),
+    Bind(Handler(rejected), holder)
+  };
+
+  then->Call(promise, 2, argv);
+}
+
+void *PromiseFactory::TakeBaton(Handle<v8::Value> holder) {
+  if (!holder->IsObject()) {
+    return NULL;
+  }
+
+  Local<v8::Value> baton = holder->ToObject()->GetHiddenValue(NanNew("baton"));
+
+  if (baton.IsEmpty() || !baton->IsExternal()) {
+    return NULL;
+  }
+
+  holder->ToObject()->DeleteHiddenValue(NanNew("baton"));
+
+  return External::Cast(*baton)->Value();
+}
+
+Persistent<Function> PromiseFactory::constructor;
+Persistent<Function> PromiseFactory::executor;
+Persistent<Array> PromiseFactory::pending;
+std::map<NanFunctionCallback, Persistent<Function> *> PromiseFactory::handlers;
@@ -0,0 +1,271 @@
+#include <nan.h>
+#include <node.h>
+#include <node_buffer.h>
+#include <limits>
+#include <string>
+
+#include "../include/revwalk_filter.h"
+
+using namespace v8;
+using namespace node;
+
+RevwalkFilter::RevwalkFilter()
+  : hasAuthor(false), hasCommitter(false),
+    since(std::numeric_limits<git_time_t>::min()),
+    until(std::numeric_limits<git_time_t>::max()),
+    minParents(0), maxParents(std::numeric_limits<unsigned int>::max()) {
+  uv_mutex_init(&matching);
+}
+
+RevwalkFilter::~RevwalkFilter() {
+  if (hasAuthor) {
+    regfree(&author);
+  }
+  if (hasCommitter) {
+    regfree(&committer);
+  }
+
+  for (size_t i = 0; i < paths.size(); i++) {
+    delete paths[i];
+  }
+
+  uv_mutex_destroy(&matching);
+}
+
+void RevwalkFilter::InitializeComponent(Handle<v8::Object> target) {
+  NanScope();
+
+  Local<FunctionTemplate> tpl = NanNew<FunctionTemplate>(JSNewFunction);
+
+  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->SetClassName(NanNew<String>("RevwalkFilter"));
+
+  NanAssignPersistent(constructor_template, tpl);
+  target->Set(NanNew<String>("RevwalkFilter"), tpl->GetFunction());
+}
+
+/*
+ * @param Object options
+ *   author, committer: String POSIX extended regular expressions
+ *   authorIgnoreCase, committerIgnoreCase: Boolean
+ *   since, until: Number seconds since the epoch
+ *   minParents, maxParents: Number
+ *   hide: Buffer of packed oids
+ *   paths: Array of Strings
+ */
+NAN_METHOD(RevwalkFilter::JSNewFunction) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsObject()) {
+    return NanThrowError("Object options is required.");
+  }
+
+  RevwalkFilter *object = new RevwalkFilter();
+  const char *error = object->Configure(args[0]->ToObject());
+
+  if (error != NULL) {
+    std::string message = error;
+
+    delete object;
+    return NanThrowError(message.c_str());
+  }
+
+  object->Wrap(args.This());
+
+  NanReturnValue(args.This());
+}
+
+const char *RevwalkFilter::Compile(regex_t *pattern, bool *compiled,
+    Handle<v8::Value> source, Handle<v8::Value> ignoreCase) {
+  int flags = REG_EXTENDED | REG_NOSUB;
+
+  if (source->IsUndefined() || source->IsNull()) {
+    return NULL;
+  }
+
+  if (!source->IsString()) {
+    return "Patterns must be Strings.";
+  }
+
+  if (ignoreCase->BooleanValue()) {
+    flags |= REG_ICASE;
+  }
+
+  int result = regcomp(pattern, *NanUtf8String(source), flags);
+
+  if (result != 0) {
+    regerror(result, pattern, this->error, sizeof(this->error));
+    return this->error;
+  }
+
+  *compiled = true;
+
+  return NULL;
+}
+
+const char *RevwalkFilter::Configure(Handle<Object> options) {
+  const char *error;
+
+  if ((error = Compile(&author, &hasAuthor,
+      options->Get(NanNew<String>("author")),
+      options->Get(NanNew<String>("authorIgnoreCase")))) != NULL
+      || (error = Compile(&committer, &hasCommitter,
+        options->Get(NanNew<String>("committer")),
+        options->Get(NanNew<String>("committerIgnoreCase")))) != NULL) {
+    return error;
+  }
+
+  Local<v8::Value> value = options->Get(NanNew<String>("since"));
+  if (value->IsNumber()) {
+    since = (git_time_t)value->NumberValue();
+  }
+
+  value = options->Get(NanNew<String>("until"));
+  if (value->IsNumber()) {
+    until = (git_time_t)value->NumberValue();
+  }
+
+  value = options->Get(NanNew<String>("minParents"));
+  if (value->IsNumber()) {
+    minParents = value->Uint32Value();
+  }
+
+  value = options->Get(NanNew<String>("maxParents"));
+  if (value->IsNumber()) {
+    maxParents = value->Uint32Value();
+  }
+
+  value = options->Get(NanNew<String>("hide"));
+  if (!value->IsUndefined() && !value->IsNull()) {
+    if (!node::Buffer::HasInstance(value)
+        || node::Buffer::Length(value) % sizeof(git_oid) != 0) {
+      return "hide must be a Buffer of packed oids.";
+    }
+
+    const git_oid *ids = (const git_oid *)node::Buffer::Data(value);
+    size_t count = node::Buffer::Length(value) / sizeof(git_oid);
+
+    hidden.reserve(count);
+    hidden.insert(ids, ids + count);
+  }
+
+  value = options->Get(NanNew<String>("paths"));
+  if (!value->IsUndefined() && !value->IsNull()) {
+    if (!value->IsArray()) {
+      return "paths must be an Array of Strings.";
+    }
+
+    Local<Array> array = Local<Array>::Cast(value);
+
+    for (uint32_t i = 0; i < array->Length(); i++) {
+      Local<v8::Value> path = array->Get(i);
+
+      if (!path->IsString()) {
+        return "paths must be an Array of Strings.";
+      }
+
+      paths.push_back(new PathHistory(*NanUtf8String(path), false));
+    }
+  }
+
+  return NULL;
+}
+
+RevwalkFilter *RevwalkFilter::FromValue(Handle<v8::Value> value) {
+  if (!value->IsObject() || !NanNew(constructor_template)->HasInstance(value)) {
+    return NULL;
+  }
+
+  return ObjectWrap::Unwrap<RevwalkFilter>(value->ToObject());
+}
+
+int RevwalkFilter::Hide(const git_oid *id, void *payload) {
+  const RevwalkFilter *filter = static_cast<const RevwalkFilter *>(payload);
+
+  return filter->hidden.count(*id) != 0;
+}
+
+bool RevwalkFilter::MatchesPerson(const regex_t *pattern,
+    const git_signature *person) const {
+  std::string text = std::string(person->name) + " <" + person->email + ">";
+
+  uv_mutex_lock(&matching);
+  bool matches = regexec(pattern, text.c_str(), 0, NULL, 0) == 0;
+  uv_mutex_unlock(&matching);
+
+  return matches;
+}
+
+// Like `git log --full-history -- <paths>`, a commit that leaves every path
+// as one of its parents had it doesn't count as a change.
+int RevwalkFilter::ChangesPaths(git_repository *repo, git_commit *commit,
+    bool *changes) const {
+  unsigned int parentCount = git_commit_parentcount(commit);
+  git_commit *parent = NULL;
+  int error = GIT_OK;
+
+  *changes = false;
+
+  if (parentCount == 0) {
+    for (size_t i = 0; i < paths.size() && !*changes && error == GIT_OK; i++) {
+      error = paths[i]->Differs(repo, git_commit_tree_id(commit), NULL,
+        changes);
+    }
+
+    return error;
+  }
+
+  for (unsigned int i = 0; i < parentCount && error == GIT_OK; i++) {
+    bool differs = false;
+
+    if ((error = git_commit_parent(&parent, commit, i)) != GIT_OK) {
+      break;
+    }
+
+    for (size_t j = 0; j < paths.size() && !differs && error == GIT_OK; j++) {
+      error = paths[j]->Differs(repo, git_commit_tree_id(commit),
+        git_commit_tree_id(parent), &differs);
+    }
+
+    git_commit_free(parent);
+    parent = NULL;
+
+    *changes = differs;
+
+    if (!differs) {
+      break;
+    }
+  }
+
+  return error;
+}
+
+int RevwalkFilter::Matches(git_repository *repo, const git_oid *id,
+    bool *matches) const {
+  git_commit *commit = NULL;
+  int error = git_commit_lookup(&commit, repo, id);
+
+  if (error != GIT_OK) {
+    return error;
+  }
+
+  unsigned int parentCount = git_commit_parentcount(commit);
+  git_time_t time = git_commit_time(commit);
+
+  *matches = parentCount >= minParents && parentCount <= maxParents
+    && time >= since && time <= until
+    && (!hasAuthor || MatchesPerson(&author, git_commit_author(commit)))
+    && (!hasCommitter
+      || MatchesPerson(&committer, git_commit_committer(commit)));
+
+  // Paths go last, as they are the only check that reads more objects.
+  if (*matches && !paths.empty()) {
+    error = ChangesPaths(repo, commit, matches);
+  }
+
+  git_commit_free(commit);
+
+  return error;
+}
+
+Persistent<FunctionTemplate> RevwalkFilter::constructor_template;
@@ -0,0 +1,152 @@
+#include <nan.h>
+#include <node.h>
+
+#include "../include/scope.h"
+
+using namespace v8;
+using namespace node;
+
+Scope::Scope()
+  : nextEntry(1)
+  , pending(0)
+  , disposing(false)
+  , disposed(false) {}
+
+void Scope::InitializeComponent(Handle<v8::Object> target) {
+  NanScope();
+
+  Local<FunctionTemplate> tpl = NanNew<FunctionTemplate>(JSNewFunction);
+
+  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->SetClassName(NanNew<String>("Scope"));
+
+  NODE_SET_PROTOTYPE_METHOD(tpl, "run", Run);
+  NODE_SET_PROTOTYPE_METHOD(tpl, "dispose", Dispose);
+  NODE_SET_PROTOTYPE_METHOD(tpl, "size", Size);
+
+  NanAssignPersistent(constructor_template, tpl);
+  target->Set(NanNew<String>("Scope"), tpl->GetFunction());
+}
+
+NAN_METHOD(Scope::JSNewFunction) {
+  NanScope();
+
+  Scope *object = new Scope();
+  object->Wrap(args.This());
+
+  NanReturnValue(args.This());
+}
+
+uint64_t Scope::Track(ObjectWrap *wrapper, Disposer disposer) {
+  if (disposed) {
+    return 0;
+  }
+
+  // Tracked wrappers point at the scope, so it has to outlive them.
+  if (entries.empty()) {
+    Ref();
+  }
+
+  Entry entry = { wrapper, disposer };
+  entries[nextEntry] = entry;
+
+  return nextEntry++;
+}
+
+void Scope::Forget(uint64_t entry) {
+  if (entries.erase(entry) && entries.empty()) {
+    Unref();
+  }
+}
+
+void Scope::Enter() {
+  pending++;
+}
+
+void Scope::Leave() {
+  pending--;
+
+  if (disposing && pending == 0) {
+    DisposeAll();
+  }
+}
+
+void Scope::DisposeAll() {
+  disposing = false;
+  disposed = true;
+
+  if (entries.empty()) {
+    return;
+  }
+
+  // Disposers clear the wrapper's scope, so none of them call Forget.
+  std::map<uint64_t, Entry> doomed;
+  doomed.swap(entries);
+
+  for (std::map<uint64_t, Entry>::reverse_iterator it = doomed.rbegin();
+      it != doomed.rend(); ++it) {
+    it->second.disposer(it->second.wrapper);
+  }
+
+  Unref();
+}
+
+/*
+ * Calls `fn` with this as the current scope, so the calls it starts join
+ * it even when nothing passed to them is in a scope yet.
+ *
+ * @param Function fn
+ * @return whatever fn returns
+ */
+NAN_METHOD(Scope::Run) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsFunction()) {
+    return NanThrowError("Function fn is required.");
+  }
+
+  Scope *scope = ObjectWrap::Unwrap<Scope>(args.This());
+
+  if (scope->disposed || scope->disposing) {
+    return NanThrowError("Scope has already been disposed of.");
+  }
+
+  Creating creating(scope);
+  Local<v8::Value> result = args[0].As<Function>()->Call(args.This(), 0, NULL);
+
+  // Empty when fn threw, which is left to propagate.
+  if (result.IsEmpty()) {
+    NanReturnUndefined();
+  }
+
+  NanReturnValue(result);
+}
+
+NAN_METHOD(Scope::Dispose) {
+  NanScope();
+
+  Scope *scope = ObjectWrap::Unwrap<Scope>(args.This());
+
+  if (!scope->disposed) {
+    if (scope->pending > 0) {
+      scope->disposing = true;
+    }
+    else {
+      scope->DisposeAll();
+    }
+  }
+
+  NanReturnUndefined();
+}
+
+// How many wrappers are waiting to be disposed of.
+NAN_METHOD(Scope::Size) {
+  NanScope();
+
+  Scope *scope = ObjectWrap::Unwrap<Scope>(args.This());
+
+  NanReturnValue(NanNew<Number>(scope->entries.size()));
+}
+
+Persistent<FunctionTemplate> Scope::constructor_template;
+Scope *Scope::current = NULL;
@@ -0,0 +1,181 @@
+#include <nan.h>
+#include <stdlib.h>
+#include <string.h>
+#include <uv.h>
+
+#include "../include/stats.h"
+
+using namespace v8;
+
+void Stats::Histogram::Record(uint64_t nanoseconds) {
+  uint64_t microseconds = nanoseconds / 1000;
+  int bucket = 0;
+
+  while (bucket < BUCKETS - 1 && microseconds >= ((uint64_t)2 << bucket)) {
+    bucket++;
+  }
+
+  count++;
+  total += nanoseconds;
+  if (nanoseconds > max) {
+    max = nanoseconds;
+  }
+  buckets[bucket]++;
+}
+
+void Stats::Histogram::Reset() {
+  count = 0;
+  total = 0;
+  max = 0;
+  memset(buckets, 0, sizeof(buckets));
+}
+
+Local<Object> Stats::Histogram::ToObject() {
+  NanEscapableScope();
+
+  Local<Object> result = NanNew<Object>();
+  Local<Array> counts = NanNew<Array>(BUCKETS);
+
+  // Bucket i counts samples under 2^(i + 1) microseconds that didn't fit in
+  // the bucket before it.
+  for (int i = 0; i < BUCKETS; i++) {
+    counts->Set(i, NanNew<Number>(buckets[i]));
+  }
+
+  // Reported in milliseconds, like ThreadPool.getStats.
+  result->Set(NanNew<String>("count"), NanNew<Number>(count));
+  result->Set(NanNew<String>("total"), NanNew<Number>(total / 1e6));
+  result->Set(NanNew<String>("max"), NanNew<Number>(max / 1e6));
+  result->Set(NanNew<String>("mean"),
+    NanNew<Number>(count ? total / 1e6 / count : 0));
+  result->Set(NanNew<String>("buckets"), counts);
+
+  return NanEscapeScope(result);
+}
+
+Stats::SyncTimer::~SyncTimer() {
+  if (function == NULL) {
+    return;
+  }
+
+  function->calls++;
+  function->sync.Record(uv_hrtime() - startedAt);
+}
+
+Stats::CompletionTimer::~CompletionTimer() {
+  if (function == NULL) {
+    return;
+  }
+
+  function->calls++;
+  function->complete.Record(uv_hrtime() - startedAt);
+
+  if (timing->startedAt) {
+    function->queueWait.Record(timing->startedAt - timing->queuedAt);
+    function->execute.Record(timing->finishedAt - timing->startedAt);
+  }
+}
+
+void Stats::InitializeComponent(Handle<v8::Object> target) {
+  NanScope();
+
+  const char *fromEnv = getenv("NODEGIT_STATS");
+  enabled = fromEnv != NULL && *fromEnv != '\0' && strcmp(fromEnv, "0") != 0;
+
+  Local<Object> object = NanNew<Object>();
+
+  NODE_SET_METHOD(object, "enable", Enable);
+  NODE_SET_METHOD(object, "disable", Disable);
+  NODE_SET_METHOD(object, "isEnabled", JSIsEnabled);
+  NODE_SET_METHOD(object, "reset", Reset);
+  NODE_SET_METHOD(object, "get", Get);
+
+  target->Set(NanNew<String>("Stats"), object);
+}
+
+Stats::Function *Stats::Register(const char *name) {
+  Function *function = new Function();
+
+  function->name = name;
+  function->calls = 0;
+  function->queueWait.Reset();
+  function->execute.Reset();
+  function->complete.Reset();
+  function->sync.Reset();
+
+  functions.push_back(function);
+
+  return function;
+}
+
+NAN_METHOD(Stats::Enable) {
+  NanScope();
+
+  enabled = true;
+
+  NanReturnUndefined();
+}
+
+NAN_METHOD(Stats::Disable) {
+  NanScope();
+
+  enabled = false;
+
+  NanReturnUndefined();
+}
+
+NAN_METHOD(Stats::JSIsEnabled) {
+  NanScope();
+
+  NanReturnValue(NanNew<Boolean>(enabled));
+}
+
+NAN_METHOD(Stats::Reset) {
+  NanScope();
+
+  for (size_t i = 0; i < functions.size(); i++) {
+    functions[i]->calls = 0;
+    functions[i]->queueWait.Reset();
+    functions[i]->execute.Reset();
+    functions[i]->complete.Reset();
+    functions[i]->sync.Reset();
+  }
+
+  NanReturnUndefined();
+}
+
+// Only bindings that have been called show up.
+NAN_METHOD(Stats::Get) {
+  NanScope();
+
+  Local<Object> result = NanNew<Object>();
+
+  for (size_t i = 0; i < functions.size(); i++) {
+    Function *function = functions[i];
+
+    if (function->calls == 0) {
+      continue;
+    }
+
+    Local<Object> entry = NanNew<Object>();
+
+    entry->Set(NanNew<String>("calls"), NanNew<Number>(function->calls));
+
+    // A binding is either sync or async, so only one set of timings applies.
+    if (function->sync.Count() > 0) {
+      entry->Set(NanNew<String>("blocking"), function->sync.ToObject());
+    }
+    else {
+      entry->Set(NanNew<String>("queueWait"), function->queueWait.ToObject());
+      entry->Set(NanNew<String>("execute"), function->execute.ToObject());
+      entry->Set(NanNew<String>("complete"), function->complete.ToObject());
+    }
+
+    result->Set(NanNew<String>(function->name), entry);
+  }
+
+  NanReturnValue(result);
+}
+
+bool Stats::enabled = false;
+std::vector<Stats::Function *> Stats::functions;
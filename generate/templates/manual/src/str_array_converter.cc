@@ -10,54 +10,66 @@ using namespace v8;
 using namespace node;
 
 git_strarray *StrArrayConverter::Convert(Handle<v8::Value> val) {
+  return ConvertValue(val, NULL);
+}
+
+git_strarray *StrArrayConverter::Convert(Handle<v8::Value> val, ArgumentArena &arena) {
+  return ConvertValue(val, &arena);
+}
+
+git_strarray *StrArrayConverter::ConvertValue(Handle<v8::Value> val, ArgumentArena *arena) {
   if (!val->BooleanValue()) {
     return NULL;
   }
   else if (val->IsArray()) {
-    return ConvertArray(Array::Cast(*val));
+    return ConvertArray(Array::Cast(*val), arena);
   }
   else if (val->IsString() || val->IsStringObject()) {
-    return ConvertString(val->ToString());
+    return ConvertString(val->ToString(), arena);
   }
   else {
     return NULL;
   }
 }
 
-git_strarray * StrArrayConverter::AllocStrArray(const size_t count) {
+git_strarray * StrArrayConverter::AllocStrArray(const size_t count, ArgumentArena *arena) {
   const size_t size = sizeof(git_strarray) + (sizeof(char*) * count);
-  uint8_t* memory = reinterpret_cast<uint8_t*>(malloc(size));
+  uint8_t* memory = reinterpret_cast<uint8_t*>(arena ? arena->Alloc(size) : malloc(size));
   git_strarray *result = reinterpret_cast<git_strarray *>(memory);
   result->count = count;
   result->strings = reinterpret_cast<char**>(memory + sizeof(git_strarray));
   return result;
 }
 
-git_strarray *StrArrayConverter::ConvertArray(Array *val) {
-  git_strarray *result = AllocStrArray(val->Length());
+char *StrArrayConverter::CopyString(const char *str, ArgumentArena *arena) {
+  return arena ? arena->Strdup(str) : strdup(str);
+}
+
+git_strarray *StrArrayConverter::ConvertArray(Array *val, ArgumentArena *arena) {
+  git_strarray *result = AllocStrArray(val->Length(), arena);
 
   for(size_t i = 0; i < result->count; i++) {
     NanUtf8String entry(val->Get(i));
-    result->strings[i] = strdup(*entry);
+    result->strings[i] = CopyString(*entry, arena);
   }
 
   return result;
 }
 
-git_strarray* StrArrayConverter::ConvertString(Handle<String> val) {
+git_strarray* StrArrayConverter::ConvertString(Handle<String> val, ArgumentArena *arena) {
   char *strings[1];
   NanUtf8String utf8String(val);
 
   strings[0] = *utf8String;
 
-  return ConstructStrArray(1, strings);
+  return ConstructStrArray(1, strings, arena);
 }
 
-git_strarray *StrArrayConverter::ConstructStrArray(int argc, char** argv) {
-  git_strarray *result = AllocStrArray(argc);
+git_strarray *StrArrayConverter::ConstructStrArray(int argc, char** argv, ArgumentArena *arena) {
+  git_strarray *result = AllocStrArray(argc, arena);
 
   for(size_t i = 0; i < result->count; i++) {
-    result->strings[i] = strdup(argv[i]);
+    result->strings[i] = CopyString(argv[i], arena);
   }
 
   return result;
@@ -0,0 +1,411 @@
+#include <nan.h>
+#include <deque>
+#include <map>
+#include <queue>
+#include <stdlib.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/callback_batch.h"
+#include "../include/callback_dispatcher.h"
+#include "../include/cancel_token.h"
+#include "../include/thread_pool.h"
+#include "../include/trace_buffer.h"
+
+using namespace v8;
+
+static const unsigned int DEFAULT_SIZE = 4;
+// Threads started past the size while others wait for JS callbacks.
+static const unsigned int MAX_SPARE_THREADS = 16;
+
+void ThreadPool::InitializeComponent(Handle<v8::Object> target) {
+  NanScope();
+
+  const char *fromEnv = getenv("NODEGIT_THREADPOOL_SIZE");
+  int requested = fromEnv ? atoi(fromEnv) : 0;
+  size = requested > 0 ? (unsigned int)requested : DEFAULT_SIZE;
+
+  uv_mutex_init(&mutex);
+  uv_cond_init(&available);
+  uv_key_create(&currentWork);
+  uv_async_init(uv_default_loop(), &completedHandle, (uv_async_cb) Completed);
+
+  // Only referenced while there is outstanding work, same as the libuv pool.
+  uv_unref((uv_handle_t *) &completedHandle);
+
+  Local<Object> object = NanNew<Object>();
+
+  NODE_SET_METHOD(object, "setSize", SetSize);
+  NODE_SET_METHOD(object, "getSize", GetSize);
+  NODE_SET_METHOD(object, "getStats", GetStats);
+
+  target->Set(NanNew<String>("ThreadPool"), object);
+}
+
+void ThreadPool::QueueWork(
+  NanAsyncWorker *worker,
+  Priority priority,
+  const void *repo,
+  Access access,
+  CancelToken *token,
+  Timing *timing
+) {
+  Work work = { worker, priority, repo, access, token, timing, uv_hrtime() };
+
+  if (outstanding++ == 0) {
+    uv_ref((uv_handle_t *) &completedHandle);
+  }
+
+  // Work queued by a callback its own job is waiting on, as opposed to any
+  // other callback that happens to be waiting on the same repository.
+  const Work *issuer = static_cast<const Work *>(CallbackDispatcher::Origin());
+  bool forCallback = issuer != NULL && issuer->repo == repo;
+
+  if (repo && !Admit(work, forCallback)) {
+    repos[repo].waiting.push_back(work);
+    blocked++;
+    return;
+  }
+
+  Dispatch(work);
+}
+
+void ThreadPool::CompleteWork(NanAsyncWorker *worker) {
+  Work work = { worker, INTERACTIVE, NULL, READ, NULL, NULL, uv_hrtime() };
+
+  if (outstanding++ == 0) {
+    uv_ref((uv_handle_t *) &completedHandle);
+  }
+
+  uv_mutex_lock(&mutex);
+  completed.push(work);
+  uv_mutex_unlock(&mutex);
+
+  uv_async_send(&completedHandle);
+}
+
+ThreadPool::CallbackWait::CallbackWait() {
+  work = static_cast<const Work *>(uv_key_get(&currentWork));
+
+  if (work == NULL) {
+    return;
+  }
+
+  // Whatever the callback queues while it runs is part of this job.
+  CallbackDispatcher::SetOrigin(work);
+
+  uv_mutex_lock(&mutex);
+
+  // The callback may queue work of its own and wait for it, so this thread
+  // gives up its place until the callback is done.
+  running[work->priority]--;
+  released++;
+  SpawnIfNeeded();
+  uv_cond_broadcast(&available);
+
+  uv_mutex_unlock(&mutex);
+}
+
+ThreadPool::CallbackWait::~CallbackWait() {
+  if (work == NULL) {
+    return;
+  }
+
+  CallbackDispatcher::SetOrigin(NULL);
+
+  uv_mutex_lock(&mutex);
+
+  // Takes its place back even if a spare thread has filled it meanwhile;
+  // the pool is over its size only until one of them finishes.
+  running[work->priority]++;
+  released--;
+
+  uv_mutex_unlock(&mutex);
+}
+
+// Takes a slot on the work's repository if it can run right now. Anything
+// already waiting goes first, so a stream of readers can't starve a writer.
+bool ThreadPool::Admit(const Work &work, bool forCallback) {
+  RepoState &state = repos[work.repo];
+
+  // The job that holds the repository may be waiting on this work.
+  if (forCallback) {
+    if (work.access == WRITE) {
+      state.writers++;
+    }
+    else {
+      state.readers++;
+    }
+
+    return true;
+  }
+
+  if (!state.waiting.empty() || state.writers > 0) {
+    return false;
+  }
+
+  if (work.access == WRITE) {
+    if (state.readers > 0) {
+      return false;
+    }
+
+    state.writers++;
+  }
+  else {
+    state.readers++;
+  }
+
+  return true;
+}
+
+void ThreadPool::Release(const Work &work) {
+  std::map<const void *, RepoState>::iterator found = repos.find(work.repo);
+  RepoState &state = found->second;
+
+  if (work.access == WRITE) {
+    state.writers--;
+  }
+  else {
+    state.readers--;
+  }
+
+  while (!state.waiting.empty()) {
+    Work next = state.waiting.front();
+
+    if (state.writers > 0 || (next.access == WRITE && state.readers > 0)) {
+      break;
+    }
+
+    state.waiting.pop_front();
+    blocked--;
+
+    if (next.access == WRITE) {
+      state.writers++;
+    }
+    else {
+      state.readers++;
+    }
+
+    Dispatch(next);
+  }
+
+  if (state.writers == 0 && state.readers == 0 && state.waiting.empty()) {
+    repos.erase(found);
+  }
+}
+
+void ThreadPool::Dispatch(const Work &work) {
+  uv_mutex_lock(&mutex);
+  queues[work.priority].push(work);
+  SpawnIfNeeded();
+  // Threads past the current size or waiting on a bulk slot can't take every
+  // job, so wake all of them and let CanRun sort it out.
+  uv_cond_broadcast(&available);
+  uv_mutex_unlock(&mutex);
+}
+
+// Called with the mutex held.
+unsigned int ThreadPool::Capacity() {
+  return size + (released < MAX_SPARE_THREADS ? released : MAX_SPARE_THREADS);
+}
+
+// Called with the mutex held.
+void ThreadPool::SpawnIfNeeded() {
+  unsigned int busy = running[INTERACTIVE] + running[BULK] + released;
+  unsigned int waiting = queues[INTERACTIVE].size() + queues[BULK].size();
+
+  while (threadCount < Capacity() && threadCount < busy + waiting) {
+    uv_thread_t thread;
+    uv_thread_create(&thread, RunThread, (void *)(uintptr_t)threadCount);
+    threadCount++;
+  }
+}
+
+// Called with the mutex held.
+bool ThreadPool::CanRun(unsigned int index) {
+  if (index >= Capacity()) {
+    return false;
+  }
+
+  if (!queues[INTERACTIVE].empty()) {
+    return true;
+  }
+
+  unsigned int bulkLimit = size > 1 ? size - 1 : 1;
+  return !queues[BULK].empty() && running[BULK] < bulkLimit;
+}
+
+void ThreadPool::RunThread(void *data) {
+  unsigned int index = (unsigned int)(uintptr_t)data;
+
+  uv_mutex_lock(&mutex);
+
+  for (;;) {
+    while (!CanRun(index)) {
+      uv_cond_wait(&available, &mutex);
+    }
+
+    Priority priority = queues[INTERACTIVE].empty() ? BULK : INTERACTIVE;
+    Work work = queues[priority].front();
+    queues[priority].pop();
+    running[priority]++;
+
+    uint64_t startedAt = uv_hrtime();
+    uint64_t wait = startedAt - work.queuedAt;
+    counters[priority].totalWait += wait;
+    if (wait > counters[priority].maxWait) {
+      counters[priority].maxWait = wait;
+    }
+
+    uv_mutex_unlock(&mutex);
+
+    TraceBuffer::Trace(GIT_TRACE_TRACE, "nodegit: starting %s job",
+      priority == INTERACTIVE ? "interactive" : "bulk");
+
+    CancelToken::SetCurrent(work.token);
+    uv_key_set(&currentWork, &work);
+    work.worker->Execute();
+    // Progress still on its way to JS has to land before the job completes.
+    CallbackBatch::FlushPushed();
+    uv_key_set(&currentWork, NULL);
+    CancelToken::SetCurrent(NULL);
+
+    uint64_t finishedAt = uv_hrtime();
+
+    TraceBuffer::Trace(GIT_TRACE_DEBUG,
+      "nodegit: %s job ran for %.3fms after waiting %.3fms",
+      priority == INTERACTIVE ? "interactive" : "bulk",
+      (finishedAt - startedAt) / 1e6, wait / 1e6);
+
+    if (work.timing) {
+      work.timing->queuedAt = work.queuedAt;
+      work.timing->startedAt = startedAt;
+      work.timing->finishedAt = finishedAt;
+    }
+
+    uv_mutex_lock(&mutex);
+
+    running[priority]--;
+    counters[priority].completed++;
+    counters[priority].totalRun += finishedAt - startedAt;
+    completed.push(work);
+
+    // A finished bulk job may free the slot another thread is waiting for.
+    uv_cond_broadcast(&available);
+    uv_async_send(&completedHandle);
+  }
+}
+
+void ThreadPool::Completed(uv_async_t *handle, int status) {
+  std::queue<Work> done;
+
+  uv_mutex_lock(&mutex);
+  std::swap(done, completed);
+  uv_mutex_unlock(&mutex);
+
+  while (!done.empty()) {
+    Work work = done.front();
+    done.pop();
+
+    // Let whatever was waiting on the repository start before running JS.
+    if (work.repo) {
+      Release(work);
+    }
+
+    work.worker->WorkComplete();
+    work.worker->Destroy();
+
+    if (--outstanding == 0) {
+      uv_unref((uv_handle_t *) &completedHandle);
+    }
+  }
+}
+
+NAN_METHOD(ThreadPool::SetSize) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsNumber() || args[0]->Uint32Value() < 1) {
+    return NanThrowError("Size must be a positive Number.");
+  }
+
+  uv_mutex_lock(&mutex);
+  size = args[0]->Uint32Value();
+  SpawnIfNeeded();
+  uv_cond_broadcast(&available);
+  uv_mutex_unlock(&mutex);
+
+  NanReturnUndefined();
+}
+
+NAN_METHOD(ThreadPool::GetSize) {
+  NanScope();
+
+  NanReturnValue(NanNew<Number>(size));
+}
+
+static Local<Object> CountersToObject(
+  unsigned int queued,
+  unsigned int running,
+  unsigned int completed,
+  uint64_t totalWait,
+  uint64_t maxWait,
+  uint64_t totalRun
+) {
+  Local<Object> result = NanNew<Object>();
+
+  // Times are kept in nanoseconds and reported in milliseconds. Wait time
+  // includes any time spent blocked behind work on the same repository.
+  result->Set(NanNew<String>("queued"), NanNew<Number>(queued));
+  result->Set(NanNew<String>("running"), NanNew<Number>(running));
+  result->Set(NanNew<String>("completed"), NanNew<Number>(completed));
+  result->Set(NanNew<String>("waitTime"), NanNew<Number>(totalWait / 1e6));
+  result->Set(NanNew<String>("maxWaitTime"), NanNew<Number>(maxWait / 1e6));
+  result->Set(NanNew<String>("runTime"), NanNew<Number>(totalRun / 1e6));
+
+  return result;
+}
+
+NAN_METHOD(ThreadPool::GetStats) {
+  NanScope();
+
+  Local<Object> result = NanNew<Object>();
+  const char *names[2] = { "interactive", "bulk" };
+
+  uv_mutex_lock(&mutex);
+
+  result->Set(NanNew<String>("size"), NanNew<Number>(size));
+  result->Set(NanNew<String>("threads"), NanNew<Number>(threadCount));
+  // Jobs held back because another job owns their repository.
+  result->Set(NanNew<String>("blocked"), NanNew<Number>(blocked));
+  result->Set(NanNew<String>("repositories"), NanNew<Number>(repos.size()));
+
+  for (int i = INTERACTIVE; i <= BULK; i++) {
+    result->Set(NanNew<String>(names[i]), CountersToObject(
+      queues[i].size(),
+      running[i],
+      counters[i].completed,
+      counters[i].totalWait,
+      counters[i].maxWait,
+      counters[i].totalRun
+    ));
+  }
+
+  uv_mutex_unlock(&mutex);
+
+  NanReturnValue(result);
+}
+
+unsigned int ThreadPool::size = DEFAULT_SIZE;
+unsigned int ThreadPool::threadCount = 0;
+std::queue<ThreadPool::Work> ThreadPool::queues[2];
+unsigned int ThreadPool::running[2] = { 0, 0 };
+unsigned int ThreadPool::released = 0;
+ThreadPool::Counters ThreadPool::counters[2] = { { 0, 0, 0, 0 }, { 0, 0, 0, 0 } };
+unsigned int ThreadPool::outstanding = 0;
+std::map<const void *, ThreadPool::RepoState> ThreadPool::repos;
+unsigned int ThreadPool::blocked = 0;
+uv_key_t ThreadPool::currentWork;
+std::queue<ThreadPool::Work> ThreadPool::completed;
+uv_async_t ThreadPool::completedHandle;
+uv_mutex_t ThreadPool::mutex;
+uv_cond_t ThreadPool::available;
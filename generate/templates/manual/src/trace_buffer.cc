@@ -0,0 +1,110 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <uv.h>
+
+#include "../include/trace_buffer.h"
+
+void TraceBuffer::Initialize() {
+  for (uint32_t i = 0; i < CAPACITY; i++) {
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  head.store(0, std::memory_order_relaxed);
+  tail = 0;
+  dropped.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+void TraceBuffer::Write(git_trace_level_t level, const char *message) {
+  uint32_t position = head.load(std::memory_order_relaxed);
+  Slot *slot;
+
+  for (;;) {
+    slot = &slots[position & (CAPACITY - 1)];
+
+    uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+    int32_t difference = (int32_t)(sequence - position);
+
+    if (difference == 0) {
+      // On failure this reloads position, so the loop goes straight on.
+      if (head.compare_exchange_weak(position, position + 1,
+          std::memory_order_relaxed)) {
+        break;
+      }
+      continue;
+    }
+    else if (difference < 0) {
+      // Still holding the entry from the last lap, so the buffer is full.
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    // Another thread got there first.
+    position = head.load(std::memory_order_relaxed);
+  }
+
+  slot->entry.level = level;
+  slot->entry.time = uv_hrtime();
+
+  if (message == NULL) {
+    message = "";
+  }
+
+  size_t length = strlen(message);
+  if (length >= MESSAGE_SIZE) {
+    length = MESSAGE_SIZE - 1;
+  }
+  memcpy(slot->entry.message, message, length);
+  slot->entry.message[length] = '\0';
+
+  slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+void TraceBuffer::SetLevel(git_trace_level_t level) {
+  TraceBuffer::level.store(level, std::memory_order_relaxed);
+}
+
+void TraceBuffer::Trace(git_trace_level_t level, const char *format, ...) {
+  int current = TraceBuffer::level.load(std::memory_order_relaxed);
+
+  if (current == GIT_TRACE_NONE || level > current) {
+    return;
+  }
+
+  char message[MESSAGE_SIZE];
+  va_list args;
+
+  va_start(args, format);
+  vsnprintf(message, sizeof(message), format, args);
+  va_end(args);
+
+  Write(level, message);
+}
+
+bool TraceBuffer::Read(Entry *entry) {
+  Slot *slot = &slots[tail & (CAPACITY - 1)];
+
+  uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+
+  if (sequence != tail + 1) {
+    return false;
+  }
+
+  memcpy(entry, &slot->entry, sizeof(Entry));
+
+  slot->sequence.store(tail + CAPACITY, std::memory_order_release);
+  tail++;
+
+  return true;
+}
+
+uint32_t TraceBuffer::TakeDropped() {
+  return dropped.exchange(0, std::memory_order_relaxed);
+}
+
+TraceBuffer::Slot TraceBuffer::slots[TraceBuffer::CAPACITY];
+std::atomic<uint32_t> TraceBuffer::head(0);
+uint32_t TraceBuffer::tail = 0;
+std::atomic<uint32_t> TraceBuffer::dropped(0);
+std::atomic<int> TraceBuffer::level(GIT_TRACE_NONE);
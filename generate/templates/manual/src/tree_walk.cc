@@ -0,0 +1,236 @@
+#include <nan.h>
+#include <node.h>
+#include <node_buffer.h>
+#include <string>
+
+#include "../include/tree_walk.h"
+
+using namespace v8;
+using namespace node;
+
+void TreeWalkBatch::Add(const std::string &path, const git_oid *id,
+    uint32_t mode) {
+  paths.push_back(path);
+  ids.push_back(*id);
+  modes.push_back(mode);
+}
+
+/*
+ * {
+ *   count: Number,
+ *   paths: [String], relative to the tree walked,
+ *   ids: Buffer of packed oids,
+ *   modes: [Number]
+ * }
+ *
+ * Every array has an entry per tree entry, in the order they were walked.
+ */
+Handle<Object> TreeWalkBatch::ToColumns() const {
+  NanEscapableScope();
+
+  uint32_t count = (uint32_t)ids.size();
+
+  Local<Object> idBuffer = NanNewBufferHandle(count * GIT_OID_RAWSZ);
+  git_oid *idData = (git_oid *)node::Buffer::Data(idBuffer);
+
+  Local<Array> pathArray = NanNew<Array>(count);
+  Local<Array> modeArray = NanNew<Array>(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    idData[i] = ids[i];
+    pathArray->Set(i,
+      NanNew<String>(paths[i].data(), (int)paths[i].size()));
+    modeArray->Set(i, NanNew<Number>(modes[i]));
+  }
+
+  Local<Object> result = NanNew<Object>();
+
+  result->Set(NanNew<String>("count"), NanNew<Number>(count));
+  result->Set(NanNew<String>("paths"), pathArray);
+  result->Set(NanNew<String>("ids"), idBuffer);
+  result->Set(NanNew<String>("modes"), modeArray);
+
+  return NanEscapeScope(result);
+}
+
+TreeWalk::TreeWalk()
+  : started(false), postOrder(false), blobsOnly(false) {
+}
+
+TreeWalk::~TreeWalk() {
+  for (size_t i = 0; i < stack.size(); i++) {
+    git_tree_free(stack[i].tree);
+  }
+}
+
+void TreeWalk::InitializeComponent(Handle<v8::Object> target) {
+  NanScope();
+
+  Local<FunctionTemplate> tpl = NanNew<FunctionTemplate>(JSNewFunction);
+
+  tpl->InstanceTemplate()->SetInternalFieldCount(1);
+  tpl->SetClassName(NanNew<String>("TreeWalk"));
+
+  NanAssignPersistent(constructor_template, tpl);
+  target->Set(NanNew<String>("TreeWalk"), tpl->GetFunction());
+}
+
+/*
+ * @param Object options
+ *   postOrder: Boolean, trees after what is in them
+ *   blobsOnly: Boolean
+ *   paths: Array of Strings
+ */
+NAN_METHOD(TreeWalk::JSNewFunction) {
+  NanScope();
+
+  TreeWalk *object = new TreeWalk();
+
+  if (args.Length() > 0 && args[0]->IsObject()) {
+    const char *error = object->Configure(args[0]->ToObject());
+
+    if (error != NULL) {
+      delete object;
+      return NanThrowError(error);
+    }
+  }
+
+  object->Wrap(args.This());
+
+  NanReturnValue(args.This());
+}
+
+const char *TreeWalk::Configure(Handle<Object> options) {
+  postOrder = options->Get(NanNew<String>("postOrder"))->BooleanValue();
+  blobsOnly = options->Get(NanNew<String>("blobsOnly"))->BooleanValue();
+
+  Local<v8::Value> value = options->Get(NanNew<String>("paths"));
+  if (value->IsUndefined() || value->IsNull()) {
+    return NULL;
+  }
+
+  if (!value->IsArray()) {
+    return "paths must be an Array of Strings.";
+  }
+
+  Local<Array> array = Local<Array>::Cast(value);
+
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<v8::Value> path = array->Get(i);
+
+    if (!path->IsString()) {
+      return "paths must be an Array of Strings.";
+    }
+
+    // Entry paths never start or end with a slash.
+    std::string trimmed = *NanUtf8String(path);
+    size_t start = trimmed.find_first_not_of('/');
+    size_t end = trimmed.find_last_not_of('/');
+
+    paths.push_back(start == std::string::npos
+      ? std::string()
+      : trimmed.substr(start, end - start + 1));
+  }
+
+  return NULL;
+}
+
+TreeWalk *TreeWalk::FromValue(Handle<v8::Value> value) {
+  if (!value->IsObject() || !NanNew(constructor_template)->HasInstance(value)) {
+    return NULL;
+  }
+
+  return ObjectWrap::Unwrap<TreeWalk>(value->ToObject());
+}
+
+TreeWalk::Relation TreeWalk::RelationTo(const std::string &path,
+    bool isTree) const {
+  Relation relation = paths.empty() ? INSIDE : OUTSIDE;
+
+  for (size_t i = 0; i < paths.size() && relation != INSIDE; i++) {
+    const std::string &wanted = paths[i];
+
+    if (wanted.empty()
+        || (path.compare(0, wanted.size(), wanted) == 0
+          && (path.size() == wanted.size() || path[wanted.size()] == '/'))) {
+      relation = INSIDE;
+    }
+    else if (isTree && wanted.size() > path.size()
+        && wanted.compare(0, path.size(), path) == 0
+        && wanted[path.size()] == '/') {
+      relation = ABOVE;
+    }
+  }
+
+  return relation;
+}
+
+// The stack holds every tree from the root down to the one being read, with
+// how far each has got, so the walk picks up exactly where it stopped.
+int TreeWalk::Next(TreeWalkBatch *out, git_tree *tree, size_t max) {
+  int error = GIT_OK;
+
+  if (!started) {
+    Level root = { NULL, 0, "", "", {{ 0 }}, false };
+
+    error = git_object_dup((git_object **)&root.tree, (git_object *)tree);
+    if (error != GIT_OK) {
+      return error;
+    }
+
+    stack.push_back(root);
+    started = true;
+  }
+
+  while (!stack.empty() && out->Count() < max) {
+    Level &level = stack.back();
+
+    if (level.index == git_tree_entrycount(level.tree)) {
+      if (postOrder && level.wanted) {
+        out->Add(level.path, &level.id, GIT_FILEMODE_TREE);
+      }
+
+      git_tree_free(level.tree);
+      stack.pop_back();
+      continue;
+    }
+
+    const git_tree_entry *entry =
+      git_tree_entry_byindex(level.tree, level.index++);
+    git_filemode_t mode = git_tree_entry_filemode(entry);
+    std::string path = level.prefix + git_tree_entry_name(entry);
+    Relation relation = RelationTo(path, mode == GIT_FILEMODE_TREE);
+
+    if (relation == OUTSIDE) {
+      continue;
+    }
+
+    if (mode != GIT_FILEMODE_TREE) {
+      if (relation == INSIDE && (!blobsOnly || mode == GIT_FILEMODE_BLOB
+          || mode == GIT_FILEMODE_BLOB_EXECUTABLE)) {
+        out->Add(path, git_tree_entry_id(entry), mode);
+      }
+      continue;
+    }
+
+    Level child = { NULL, 0, path + "/", path, *git_tree_entry_id(entry),
+      relation == INSIDE && !blobsOnly };
+
+    error = git_tree_lookup(&child.tree, git_tree_owner(level.tree),
+      &child.id);
+    if (error != GIT_OK) {
+      return error;
+    }
+
+    if (child.wanted && !postOrder) {
+      out->Add(child.path, &child.id, GIT_FILEMODE_TREE);
+    }
+
+    // Invalidates level.
+    stack.push_back(child);
+  }
+
+  return error;
+}
+
+Persistent<FunctionTemplate> TreeWalk::constructor_template;
@@ -0,0 +1,27 @@
+static void GitBlob_ReleaseContent(char *data, void *hint) {
+  git_object_free((git_object *)hint);
+}
+
+/*
+ * The Buffer points straight at libgit2's copy of the content and holds its
+ * own reference to the blob, which is released once the Buffer is collected.
+ *
+ * @return Buffer content
+ */
+NAN_METHOD(GitBlob::Content) {
+  NanScope();
+
+  git_blob *blob = ObjectWrap::Unwrap<GitBlob>(args.This())->GetValue();
+  git_object *owner = NULL;
+
+  if (git_object_dup(&owner, (git_object *)blob) != GIT_OK) {
+    return NanThrowError(giterr_last() ? giterr_last()->message : "Unknown Error");
+  }
+
+  NanReturnValue(NanNewBufferHandle(
+    (char *)git_blob_rawcontent(blob),
+    (size_t)git_blob_rawsize(blob),
+    GitBlob_ReleaseContent,
+    owner
+  ));
+}
@@ -0,0 +1,138 @@
+/*
+ * Counts how far each of tips is ahead of and behind base in one trip
+ * through the thread pool, with their merge bases when mergeBases is true.
+ * base is one packed oid and tips any number of them, 20 bytes each.
+ * Resolves to `{ ahead, behind, mergeBases }`: two Arrays of Numbers in the
+ * order of tips and, when asked for, a Buffer of packed oids where a tip
+ * without a merge base has a zero oid.
+ *
+ * @async
+ * @param Repository repo
+ * @param Buffer base
+ * @param Buffer tips
+ * @param Boolean mergeBases
+ * @return Object counts
+ */
+NAN_METHOD(GitGraph::AheadBehindMany) {
+  return AheadBehindManyWorker::Dispatch(args, 4, AheadBehindManyStart);
+}
+
+NAN_METHOD(GitGraph::AheadBehindManyStart) {
+  NanScope();
+
+  if (args.Length() == 0 || !GitRepository::HasInstance(args[0])) {
+    return NanThrowError("Repository repo is required.");
+  }
+
+  if (args.Length() == 1 || !node::Buffer::HasInstance(args[1])
+      || node::Buffer::Length(args[1]) != sizeof(git_oid)) {
+    return NanThrowError("Buffer base is required and must hold one oid.");
+  }
+
+  if (args.Length() == 2 || !node::Buffer::HasInstance(args[2])
+      || node::Buffer::Length(args[2]) % sizeof(git_oid) != 0) {
+    return NanThrowError("Buffer tips is required and must hold packed oids.");
+  }
+
+  GitRepository *repo = ObjectWrap::Unwrap<GitRepository>(args[0]->ToObject());
+
+  if (repo->GetValue() == NULL) {
+    return NanThrowError("Repository repo has already been freed.");
+  }
+
+  static Stats::Function *bindingStats = Stats::Register("Graph.aheadBehindMany");
+  CancelToken *cancelToken;
+
+  AheadBehindManyWorker *worker = AheadBehindManyWorker::Begin(args, 4,
+    bindingStats, repo->scope, &cancelToken);
+
+  if (worker == NULL) {
+    NanReturnUndefined();
+  }
+
+  AheadBehindManyBaton *baton = ObjectPool<AheadBehindManyBaton>::Acquire();
+  size_t count = node::Buffer::Length(args[2]) / sizeof(git_oid);
+  bool mergeBases = args.Length() > 3 && args[3]->BooleanValue();
+
+  baton->error_code = GIT_OK;
+  baton->error = NULL;
+  baton->repo = repo->GetValue();
+  baton->count = count;
+
+  // The oids are copied so the Buffers can change while the work runs.
+  git_oid *base = (git_oid *)baton->arena.Alloc(sizeof(git_oid));
+  git_oid *tips = (git_oid *)baton->arena.Alloc(count * sizeof(git_oid));
+
+  memcpy(base, node::Buffer::Data(args[1]), sizeof(git_oid));
+  memcpy(tips, node::Buffer::Data(args[2]), count * sizeof(git_oid));
+  baton->base = base;
+  baton->tips = tips;
+
+  baton->ahead = (size_t *)baton->arena.Alloc(count * sizeof(size_t));
+  baton->behind = (size_t *)baton->arena.Alloc(count * sizeof(size_t));
+  baton->bases = mergeBases
+    ? (git_oid *)baton->arena.Alloc(count * sizeof(git_oid))
+    : NULL;
+
+  worker->baton = baton;
+  worker->KeepAlive(args[0]);
+
+  worker->Queue(ThreadPool::INTERACTIVE, baton->repo,
+    ThreadPool::READ, cancelToken);
+  NanReturnUndefined();
+}
+
+void GitGraph::AheadBehindManyWorker::Execute() {
+  if (IsCancelledBeforeStart(baton)) {
+    return;
+  }
+
+  int result = nodegit_graph_ahead_behind_many(
+    baton->ahead,
+    baton->behind,
+    baton->bases,
+    baton->repo,
+    baton->base,
+    baton->tips,
+    baton->count
+  );
+
+  SetResult(baton, result);
+}
+
+void GitGraph::AheadBehindManyWorker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  TryCatch try_catch;
+
+  if (baton->error_code == GIT_OK) {
+    Local<Object> result = NanNew<Object>();
+    Local<Array> ahead = NanNew<Array>((uint32_t)baton->count);
+    Local<Array> behind = NanNew<Array>((uint32_t)baton->count);
+
+    for (uint32_t i = 0; i < baton->count; i++) {
+      ahead->Set(i, NanNew<Number>((double)baton->ahead[i]));
+      behind->Set(i, NanNew<Number>((double)baton->behind[i]));
+    }
+
+    result->Set(NanNew<String>("ahead"), ahead);
+    result->Set(NanNew<String>("behind"), behind);
+
+    if (baton->bases != NULL) {
+      result->Set(NanNew<String>("mergeBases"), NanNewBufferHandle(
+        (char *)baton->bases,
+        (uint32_t)(baton->count * sizeof(git_oid))
+      ));
+    }
+
+    Resolve(result);
+  } else {
+    RejectBaton(baton);
+  }
+
+  if (try_catch.HasCaught()) {
+    node::FatalException(try_catch);
+  }
+
+  baton->arena.Reset();
+  ObjectPool<AheadBehindManyBaton>::Release(baton);
+}
@@ -0,0 +1,122 @@
+// git_merge_base_many and git_merge_base_octopus take the same arguments, so
+// Merge.baseOctopus, which comes after this, is run by these as well.
+template<typename Worker, typename Baton>
+static _NAN_METHOD_RETURN_TYPE StartMergeBase(_NAN_METHOD_ARGS,
+    Stats::Function *bindingStats) {
+  NanScope();
+
+  if (args.Length() == 0 || !GitRepository::HasInstance(args[0])) {
+    return NanThrowError("Repository repo is required.");
+  }
+
+  if (args.Length() == 1 || !node::Buffer::HasInstance(args[1])
+      || node::Buffer::Length(args[1]) < 2 * sizeof(git_oid)
+      || node::Buffer::Length(args[1]) % sizeof(git_oid) != 0) {
+    return NanThrowError("Buffer ids is required and must hold two oids or more.");
+  }
+
+  GitRepository *repo = ObjectWrap::Unwrap<GitRepository>(args[0]->ToObject());
+
+  if (repo->GetValue() == NULL) {
+    return NanThrowError("Repository repo has already been freed.");
+  }
+
+  CancelToken *cancelToken;
+  Worker *worker = Worker::Begin(args, 2, bindingStats, repo->scope,
+    &cancelToken);
+
+  if (worker == NULL) {
+    NanReturnUndefined();
+  }
+
+  Baton *baton = ObjectPool<Baton>::Acquire();
+  size_t length = node::Buffer::Length(args[1]) / sizeof(git_oid);
+
+  baton->error_code = GIT_OK;
+  baton->error = NULL;
+  baton->repo = repo->GetValue();
+  baton->length = length;
+  baton->out = (git_oid *)baton->arena.Alloc(sizeof(git_oid));
+
+  // The oids are copied so the Buffer can change while the work runs.
+  git_oid *ids = (git_oid *)baton->arena.Alloc(length * sizeof(git_oid));
+
+  memcpy(ids, node::Buffer::Data(args[1]), length * sizeof(git_oid));
+  baton->input_array = ids;
+
+  worker->baton = baton;
+  worker->KeepAlive(args[0]);
+
+  worker->Queue(ThreadPool::INTERACTIVE, baton->repo, ThreadPool::READ,
+    cancelToken);
+  NanReturnUndefined();
+}
+
+template<typename Worker>
+static void RunMergeBase(Worker *worker, int (*find)(git_oid *out,
+    git_repository *repo, size_t length, const git_oid input_array[])) {
+  if (Worker::IsCancelledBeforeStart(worker->baton)) {
+    return;
+  }
+
+  Worker::SetResult(worker->baton, find(
+    worker->baton->out,
+    worker->baton->repo,
+    worker->baton->length,
+    worker->baton->input_array
+  ));
+}
+
+template<typename Worker, typename Baton>
+static void FinishMergeBase(Worker *worker) {
+  Baton *baton = worker->baton;
+  TryCatch try_catch;
+
+  if (baton->error_code == GIT_OK) {
+    Local<Object> result = NanNewBufferHandle(
+      (char *)baton->out,
+      (uint32_t)sizeof(git_oid)
+    );
+
+    worker->Resolve(result);
+  } else {
+    worker->RejectBaton(baton);
+  }
+
+  if (try_catch.HasCaught()) {
+    node::FatalException(try_catch);
+  }
+
+  baton->arena.Reset();
+  ObjectPool<Baton>::Release(baton);
+}
+
+/*
+ * Finds the best common ancestor of all the commits, to merge the first
+ * one with the rest of them at once, like `git merge-base` given them all.
+ * ids holds the commits packed back to back, 20 bytes each, like
+ * Oid.fromStrings returns. Resolves to the base as a 20 byte Buffer.
+ *
+ * @async
+ * @param Repository repo
+ * @param Buffer ids
+ * @return Buffer oid
+ */
+NAN_METHOD(GitMerge::BaseMany) {
+  return BaseManyWorker::Dispatch(args, 2, BaseManyStart);
+}
+
+NAN_METHOD(GitMerge::BaseManyStart) {
+  static Stats::Function *bindingStats = Stats::Register("Merge.baseMany");
+
+  return StartMergeBase<BaseManyWorker, BaseManyBaton>(args, bindingStats);
+}
+
+void GitMerge::BaseManyWorker::Execute() {
+  RunMergeBase(this, git_merge_base_many);
+}
+
+void GitMerge::BaseManyWorker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  FinishMergeBase<BaseManyWorker, BaseManyBaton>(this);
+}
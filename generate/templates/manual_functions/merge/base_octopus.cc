@@ -0,0 +1,28 @@
+/*
+ * Finds the common ancestor of all the commits for an octopus merge, like
+ * `git merge-base --octopus`. Takes and resolves to the same as baseMany.
+ *
+ * @async
+ * @param Repository repo
+ * @param Buffer ids
+ * @return Buffer oid
+ */
+NAN_METHOD(GitMerge::BaseOctopus) {
+  return BaseOctopusWorker::Dispatch(args, 2, BaseOctopusStart);
+}
+
+NAN_METHOD(GitMerge::BaseOctopusStart) {
+  static Stats::Function *bindingStats = Stats::Register("Merge.baseOctopus");
+
+  return StartMergeBase<BaseOctopusWorker, BaseOctopusBaton>(args,
+    bindingStats);
+}
+
+void GitMerge::BaseOctopusWorker::Execute() {
+  RunMergeBase(this, git_merge_base_octopus);
+}
+
+void GitMerge::BaseOctopusWorker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  FinishMergeBase<BaseOctopusWorker, BaseOctopusBaton>(this);
+}
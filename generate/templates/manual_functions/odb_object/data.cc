@@ -0,0 +1,27 @@
+static void GitOdbObject_ReleaseData(char *data, void *hint) {
+  git_odb_object_free((git_odb_object *)hint);
+}
+
+/*
+ * Like Blob#content, the Buffer shares libgit2's memory and keeps its own
+ * reference to the object rather than copying the data.
+ *
+ * @return Buffer data
+ */
+NAN_METHOD(GitOdbObject::Data) {
+  NanScope();
+
+  git_odb_object *object = ObjectWrap::Unwrap<GitOdbObject>(args.This())->GetValue();
+  git_odb_object *owner = NULL;
+
+  if (git_odb_object_dup(&owner, object) != GIT_OK) {
+    return NanThrowError(giterr_last() ? giterr_last()->message : "Unknown Error");
+  }
+
+  NanReturnValue(NanNewBufferHandle(
+    (char *)git_odb_object_data(object),
+    git_odb_object_size(object),
+    GitOdbObject_ReleaseData,
+    owner
+  ));
+}
@@ -0,0 +1,37 @@
+/*
+ * Parses every hex string in the array in one call. The oids are packed
+ * back to back, 20 bytes each, into a single Buffer; Oid.at slices one out.
+ *
+ * @param Array strings
+ * @return Buffer oids
+ */
+NAN_METHOD(GitOid::FromStrings) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsArray()) {
+    return NanThrowError("Array strings is required.");
+  }
+
+  Local<Array> strings = Local<Array>::Cast(args[0]);
+  uint32_t count = strings->Length();
+  Local<Object> result = NanNewBufferHandle(count * GIT_OID_RAWSZ);
+  git_oid *oids = (git_oid *)node::Buffer::Data(result);
+  char hex[GIT_OID_HEXSZ + 1];
+
+  for (uint32_t i = 0; i < count; i++) {
+    Local<v8::Value> string = strings->Get(i);
+
+    if (!string->IsString() || string->ToString()->Length() != GIT_OID_HEXSZ) {
+      return NanThrowError("Every entry must be a 40 character hex String.");
+    }
+
+    NanDecodeWrite(hex, GIT_OID_HEXSZ, string, Nan::ASCII);
+    hex[GIT_OID_HEXSZ] = '\0';
+
+    if (git_oid_fromstr(&oids[i], hex) != GIT_OK) {
+      return NanThrowError(giterr_last() ? giterr_last()->message : "Unknown Error");
+    }
+  }
+
+  NanReturnValue(result);
+}
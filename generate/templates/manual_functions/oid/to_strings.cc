@@ -0,0 +1,34 @@
+/*
+ * The reverse of fromStrings: formats every 20 byte oid packed into a
+ * Buffer or Uint8Array.
+ *
+ * @param Buffer oids
+ * @return Array strings
+ */
+NAN_METHOD(GitOid::ToStrings) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsObject()
+      || !args[0]->ToObject()->HasIndexedPropertiesInExternalArrayData()) {
+    return NanThrowError("Buffer oids is required.");
+  }
+
+  Local<Object> object = args[0]->ToObject();
+  int length = object->GetIndexedPropertiesExternalArrayDataLength();
+
+  if (length % GIT_OID_RAWSZ != 0) {
+    return NanThrowError("Length of oids must be a multiple of 20.");
+  }
+
+  const git_oid *oids = (const git_oid *)object->GetIndexedPropertiesExternalArrayData();
+  uint32_t count = length / GIT_OID_RAWSZ;
+  Local<Array> result = NanNew<Array>(count);
+  char hex[GIT_OID_HEXSZ];
+
+  for (uint32_t i = 0; i < count; i++) {
+    git_oid_fmt(hex, &oids[i]);
+    result->Set(i, NanNew<String>(hex, GIT_OID_HEXSZ));
+  }
+
+  NanReturnValue(result);
+}
@@ -0,0 +1,42 @@
+/*
+ * Leaves out every commit in the filter's hide set, and everything they
+ * lead to, for the rest of the walk. A walk takes one hide set, and it has
+ * to be added before anything is pushed. The walk keeps the filter alive.
+ *
+ * @param RevwalkFilter filter
+ */
+NAN_METHOD(GitRevwalk::AddHideCb) {
+  NanScope();
+
+  RevwalkFilter *filter = args.Length() > 0
+    ? RevwalkFilter::FromValue(args[0])
+    : NULL;
+
+  if (filter == NULL) {
+    return NanThrowError("RevwalkFilter filter is required.");
+  }
+
+  GitRevwalk *walker = ObjectWrap::Unwrap<GitRevwalk>(args.This());
+
+  if (walker->GetValue() == NULL) {
+    return NanThrowError("Revwalk has already been freed.");
+  }
+
+  int result = git_revwalk_add_hide_cb(
+    walker->GetValue(),
+    RevwalkFilter::Hide,
+    filter
+  );
+
+  if (result != GIT_OK) {
+    if (giterr_last()) {
+      return NanThrowError(giterr_last()->message);
+    } else {
+      return NanThrowError("Unknown Error");
+    }
+  }
+
+  args.This()->SetHiddenValue(NanNew<String>("NodeGit::hideFilter"), args[0]);
+
+  NanReturnUndefined();
+}
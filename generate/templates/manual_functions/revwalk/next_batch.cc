@@ -0,0 +1,114 @@
+/*
+ * Pops up to max oids off the walk in a single trip through the thread pool.
+ * They are packed back to back, 20 bytes each, into one Buffer; Oid.at
+ * slices one out. The Buffer is shorter than max * 20 bytes only when the
+ * walk is over, and empty once there is nothing left.
+ *
+ * @async
+ * @param Number max
+ * @return Buffer oids
+ */
+NAN_METHOD(GitRevwalk::NextBatch) {
+  return NextBatchWorker::Dispatch(args, 1, NextBatchStart);
+}
+
+NAN_METHOD(GitRevwalk::NextBatchStart) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsNumber() || args[0]->NumberValue() < 1) {
+    return NanThrowError("Number max is required.");
+  }
+
+  GitRevwalk *walker = ObjectWrap::Unwrap<GitRevwalk>(args.This());
+
+  if (walker->GetValue() == NULL) {
+    return NanThrowError("Revwalk has already been freed.");
+  }
+
+  static Stats::Function *bindingStats = Stats::Register("Revwalk.nextBatch");
+  CancelToken *cancelToken;
+
+  NextBatchWorker *worker = NextBatchWorker::Begin(args, 1, bindingStats,
+    walker->scope, &cancelToken);
+
+  if (worker == NULL) {
+    NanReturnUndefined();
+  }
+
+  NextBatchBaton *baton = ObjectPool<NextBatchBaton>::Acquire();
+
+  baton->error_code = GIT_OK;
+  baton->error = NULL;
+  baton->walk = walker->GetValue();
+  baton->max = (size_t)args[0]->NumberValue();
+
+  // The oids are written straight into the arena and copied out once.
+  baton->out = (git_oidarray *)baton->arena.Alloc(sizeof(git_oidarray));
+  baton->out->ids = (git_oid *)baton->arena.Alloc(baton->max * sizeof(git_oid));
+  baton->out->count = 0;
+
+  worker->baton = baton;
+  worker->KeepAlive(args.This());
+
+  // Steps the walk, which another call could be stepping at the same time,
+  // so it takes the repository like a writer.
+  worker->Queue(ThreadPool::INTERACTIVE, git_revwalk_repository(baton->walk),
+    ThreadPool::WRITE, cancelToken);
+  NanReturnUndefined();
+}
+
+void GitRevwalk::NextBatchWorker::Execute() {
+  if (IsCancelledBeforeStart(baton)) {
+    return;
+  }
+
+  git_oidarray *out = baton->out;
+  int result = GIT_OK;
+
+  // Running out of commits ends the batch early; it isn't an error. A big
+  // batch can take a while, so it also stops once it is cancelled.
+  while (out->count < baton->max) {
+    if (CancelToken::IsCurrentCancelled()) {
+      CancelToken::SetCancelledError();
+      result = GIT_EUSER;
+      break;
+    }
+
+    result = git_revwalk_next(&out->ids[out->count], baton->walk);
+
+    if (result != GIT_OK) {
+      break;
+    }
+
+    out->count++;
+  }
+
+  if (result == GIT_ITEROVER) {
+    result = GIT_OK;
+  }
+
+  SetResult(baton, result);
+}
+
+void GitRevwalk::NextBatchWorker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  TryCatch try_catch;
+
+  if (baton->error_code == GIT_OK) {
+    Local<Object> result = NanNewBufferHandle(
+      (char *)baton->out->ids,
+      (uint32_t)(baton->out->count * sizeof(git_oid))
+    );
+
+    Resolve(result);
+  } else {
+    RejectBaton(baton);
+  }
+
+  if (try_catch.HasCaught()) {
+    node::FatalException(try_catch);
+  }
+
+  baton->arena.Reset();
+  ObjectPool<NextBatchBaton>::Release(baton);
+}
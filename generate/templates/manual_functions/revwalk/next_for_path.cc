@@ -0,0 +1,118 @@
+/*
+ * Walks until max commits that touch path have been read, or the walk is
+ * over, comparing trees on the worker instead of diffing. Resolves to the
+ * columns described in PathHistory::ToColumns; the next call should carry
+ * on with the `path` they end with, which differs from the one passed in
+ * if a rename was followed.
+ *
+ * @async
+ * @param String path
+ * @param Number max
+ * @param Boolean followRenames
+ * @return Object columns
+ */
+NAN_METHOD(GitRevwalk::NextForPath) {
+  return NextForPathWorker::Dispatch(args, 3, NextForPathStart);
+}
+
+NAN_METHOD(GitRevwalk::NextForPathStart) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsString() || args[0]->ToString()->Length() == 0) {
+    return NanThrowError("String path is required.");
+  }
+
+  if (args.Length() == 1 || !args[1]->IsNumber() || args[1]->NumberValue() < 1) {
+    return NanThrowError("Number max is required.");
+  }
+
+  GitRevwalk *walker = ObjectWrap::Unwrap<GitRevwalk>(args.This());
+
+  if (walker->GetValue() == NULL) {
+    return NanThrowError("Revwalk has already been freed.");
+  }
+
+  static Stats::Function *bindingStats = Stats::Register("Revwalk.nextForPath");
+  CancelToken *cancelToken;
+
+  NextForPathWorker *worker = NextForPathWorker::Begin(args, 3, bindingStats,
+    walker->scope, &cancelToken);
+
+  if (worker == NULL) {
+    NanReturnUndefined();
+  }
+
+  NextForPathBaton *baton = ObjectPool<NextForPathBaton>::Acquire();
+
+  baton->error_code = GIT_OK;
+  baton->error = NULL;
+  baton->walk = walker->GetValue();
+  baton->max = (size_t)args[1]->NumberValue();
+
+  String::Utf8Value path(args[0]->ToString());
+  baton->out = new PathHistory(*path, args.Length() > 2 && args[2]->BooleanValue());
+
+  worker->baton = baton;
+  worker->KeepAlive(args.This());
+
+  // Steps the walk, which another call could be stepping at the same time,
+  // so it takes the repository like a writer.
+  worker->Queue(ThreadPool::INTERACTIVE, git_revwalk_repository(baton->walk),
+    ThreadPool::WRITE, cancelToken);
+  NanReturnUndefined();
+}
+
+void GitRevwalk::NextForPathWorker::Execute() {
+  if (IsCancelledBeforeStart(baton)) {
+    return;
+  }
+
+  git_repository *repo = git_revwalk_repository(baton->walk);
+  int result = GIT_OK;
+  git_oid id;
+
+  // Running out of commits ends the batch early; it isn't an error. Most
+  // commits are skipped, so this can take a while without finding any.
+  while (baton->out->Count() < baton->max) {
+    if (CancelToken::IsCurrentCancelled()) {
+      CancelToken::SetCancelledError();
+      result = GIT_EUSER;
+      break;
+    }
+
+    result = git_revwalk_next(&id, baton->walk);
+
+    if (result == GIT_OK) {
+      result = baton->out->Visit(repo, &id);
+    }
+
+    if (result != GIT_OK) {
+      break;
+    }
+  }
+
+  if (result == GIT_ITEROVER) {
+    result = GIT_OK;
+  }
+
+  SetResult(baton, result);
+}
+
+void GitRevwalk::NextForPathWorker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  TryCatch try_catch;
+
+  if (baton->error_code == GIT_OK) {
+    Resolve(baton->out->ToColumns());
+  } else {
+    RejectBaton(baton);
+  }
+
+  if (try_catch.HasCaught()) {
+    node::FatalException(try_catch);
+  }
+
+  delete baton->out;
+  baton->arena.Reset();
+  ObjectPool<NextForPathBaton>::Release(baton);
+}
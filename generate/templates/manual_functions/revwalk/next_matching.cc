@@ -0,0 +1,124 @@
+/*
+ * Like nextMetadata, but only for the commits that pass filter, which are
+ * checked on the worker. The walk goes on until max commits have passed,
+ * so a count below max still means the walk is over.
+ *
+ * @async
+ * @param RevwalkFilter filter
+ * @param Number max
+ * @return Object columns
+ */
+NAN_METHOD(GitRevwalk::NextMatching) {
+  return NextMatchingWorker::Dispatch(args, 2, NextMatchingStart);
+}
+
+NAN_METHOD(GitRevwalk::NextMatchingStart) {
+  NanScope();
+
+  RevwalkFilter *filter = args.Length() > 0
+    ? RevwalkFilter::FromValue(args[0])
+    : NULL;
+
+  if (filter == NULL) {
+    return NanThrowError("RevwalkFilter filter is required.");
+  }
+
+  if (args.Length() == 1 || !args[1]->IsNumber() || args[1]->NumberValue() < 1) {
+    return NanThrowError("Number max is required.");
+  }
+
+  GitRevwalk *walker = ObjectWrap::Unwrap<GitRevwalk>(args.This());
+
+  if (walker->GetValue() == NULL) {
+    return NanThrowError("Revwalk has already been freed.");
+  }
+
+  static Stats::Function *bindingStats = Stats::Register("Revwalk.nextMatching");
+  CancelToken *cancelToken;
+
+  NextMatchingWorker *worker = NextMatchingWorker::Begin(args, 2, bindingStats,
+    walker->scope, &cancelToken);
+
+  if (worker == NULL) {
+    NanReturnUndefined();
+  }
+
+  NextMatchingBaton *baton = ObjectPool<NextMatchingBaton>::Acquire();
+
+  baton->error_code = GIT_OK;
+  baton->error = NULL;
+  baton->walk = walker->GetValue();
+  baton->filter = filter;
+  baton->max = (size_t)args[1]->NumberValue();
+
+  baton->out = new CommitMetadata();
+
+  worker->baton = baton;
+  worker->KeepAlive(args.This());
+  worker->KeepAlive(args[0]);
+
+  // Steps the walk, which another call could be stepping at the same time,
+  // so it takes the repository like a writer.
+  worker->Queue(ThreadPool::INTERACTIVE, git_revwalk_repository(baton->walk),
+    ThreadPool::WRITE, cancelToken);
+  NanReturnUndefined();
+}
+
+void GitRevwalk::NextMatchingWorker::Execute() {
+  if (IsCancelledBeforeStart(baton)) {
+    return;
+  }
+
+  git_repository *repo = git_revwalk_repository(baton->walk);
+  int result = GIT_OK;
+  bool matches;
+  git_oid id;
+
+  // Running out of commits ends the batch early; it isn't an error.
+  while (baton->out->Count() < baton->max) {
+    if (CancelToken::IsCurrentCancelled()) {
+      CancelToken::SetCancelledError();
+      result = GIT_EUSER;
+      break;
+    }
+
+    result = git_revwalk_next(&id, baton->walk);
+
+    if (result == GIT_OK) {
+      result = baton->filter->Matches(repo, &id, &matches);
+    }
+
+    if (result == GIT_OK && matches) {
+      result = baton->out->Read(repo, &id);
+    }
+
+    if (result != GIT_OK) {
+      break;
+    }
+  }
+
+  if (result == GIT_ITEROVER) {
+    result = GIT_OK;
+  }
+
+  SetResult(baton, result);
+}
+
+void GitRevwalk::NextMatchingWorker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  TryCatch try_catch;
+
+  if (baton->error_code == GIT_OK) {
+    Resolve(baton->out->ToColumns());
+  } else {
+    RejectBaton(baton);
+  }
+
+  if (try_catch.HasCaught()) {
+    node::FatalException(try_catch);
+  }
+
+  delete baton->out;
+  baton->arena.Reset();
+  ObjectPool<NextMatchingBaton>::Release(baton);
+}
@@ -0,0 +1,109 @@
+/*
+ * Walks up to max commits and reads what a log view shows about them on the
+ * worker, without making a Commit for any of them. Resolves to the columns
+ * described in CommitMetadata::ToColumns, with a count below max only once
+ * the walk is over.
+ *
+ * @async
+ * @param Number max
+ * @return Object columns
+ */
+NAN_METHOD(GitRevwalk::NextMetadata) {
+  return NextMetadataWorker::Dispatch(args, 1, NextMetadataStart);
+}
+
+NAN_METHOD(GitRevwalk::NextMetadataStart) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsNumber() || args[0]->NumberValue() < 1) {
+    return NanThrowError("Number max is required.");
+  }
+
+  GitRevwalk *walker = ObjectWrap::Unwrap<GitRevwalk>(args.This());
+
+  if (walker->GetValue() == NULL) {
+    return NanThrowError("Revwalk has already been freed.");
+  }
+
+  static Stats::Function *bindingStats = Stats::Register("Revwalk.nextMetadata");
+  CancelToken *cancelToken;
+
+  NextMetadataWorker *worker = NextMetadataWorker::Begin(args, 1, bindingStats,
+    walker->scope, &cancelToken);
+
+  if (worker == NULL) {
+    NanReturnUndefined();
+  }
+
+  NextMetadataBaton *baton = ObjectPool<NextMetadataBaton>::Acquire();
+
+  baton->error_code = GIT_OK;
+  baton->error = NULL;
+  baton->walk = walker->GetValue();
+  baton->max = (size_t)args[0]->NumberValue();
+
+  baton->out = new CommitMetadata();
+
+  worker->baton = baton;
+  worker->KeepAlive(args.This());
+
+  // Steps the walk, which another call could be stepping at the same time,
+  // so it takes the repository like a writer.
+  worker->Queue(ThreadPool::INTERACTIVE, git_revwalk_repository(baton->walk),
+    ThreadPool::WRITE, cancelToken);
+  NanReturnUndefined();
+}
+
+void GitRevwalk::NextMetadataWorker::Execute() {
+  if (IsCancelledBeforeStart(baton)) {
+    return;
+  }
+
+  git_repository *repo = git_revwalk_repository(baton->walk);
+  int result = GIT_OK;
+  git_oid id;
+
+  // Running out of commits ends the batch early; it isn't an error.
+  while (baton->out->Count() < baton->max) {
+    if (CancelToken::IsCurrentCancelled()) {
+      CancelToken::SetCancelledError();
+      result = GIT_EUSER;
+      break;
+    }
+
+    result = git_revwalk_next(&id, baton->walk);
+
+    if (result == GIT_OK) {
+      result = baton->out->Read(repo, &id);
+    }
+
+    if (result != GIT_OK) {
+      break;
+    }
+  }
+
+  if (result == GIT_ITEROVER) {
+    result = GIT_OK;
+  }
+
+  SetResult(baton, result);
+}
+
+void GitRevwalk::NextMetadataWorker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  TryCatch try_catch;
+
+  if (baton->error_code == GIT_OK) {
+    Resolve(baton->out->ToColumns());
+  } else {
+    RejectBaton(baton);
+  }
+
+  if (try_catch.HasCaught()) {
+    node::FatalException(try_catch);
+  }
+
+  delete baton->out;
+  baton->arena.Reset();
+  ObjectPool<NextMetadataBaton>::Release(baton);
+}
@@ -0,0 +1,33 @@
+/*
+ * Takes the messages traced since the last drain, oldest first. Each is
+ * an object with `level`, `time` (milliseconds on the process.hrtime clock)
+ * and `message`.
+ *
+ * @param Number [max] most messages to take, all of them by default
+ * @return Array messages
+ */
+NAN_METHOD(GitTrace::Drain) {
+  NanScope();
+
+  uint32_t max = TraceBuffer::CAPACITY;
+  if (args.Length() > 0 && args[0]->IsNumber()) {
+    max = args[0]->Uint32Value();
+  }
+
+  Local<Array> result = NanNew<Array>();
+  Local<String> levelKey = NanNew<String>("level");
+  Local<String> timeKey = NanNew<String>("time");
+  Local<String> messageKey = NanNew<String>("message");
+  TraceBuffer::Entry entry;
+
+  for (uint32_t i = 0; i < max && TraceBuffer::Read(&entry); i++) {
+    Local<Object> message = NanNew<Object>();
+
+    message->Set(levelKey, NanNew<Number>(entry.level));
+    message->Set(timeKey, NanNew<Number>(entry.time / 1e6));
+    message->Set(messageKey, NanNew<String>(entry.message));
+    result->Set(i, message);
+  }
+
+  NanReturnValue(result);
+}
@@ -0,0 +1,11 @@
+/*
+ * How many messages were dropped because the buffer was full since the
+ * last call. Draining more often, or at a lower level, drops fewer.
+ *
+ * @return Number dropped
+ */
+NAN_METHOD(GitTrace::Dropped) {
+  NanScope();
+
+  NanReturnValue(NanNew<Number>(TraceBuffer::TakeDropped()));
+}
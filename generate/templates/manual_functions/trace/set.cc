@@ -0,0 +1,32 @@
+/*
+ * Sends libgit2's trace messages at `level` and below to the trace buffer,
+ * where Trace.drain picks them up. Trace.LEVEL.NONE turns tracing off.
+ *
+ * @param Number level
+ */
+NAN_METHOD(GitTrace::Set) {
+  NanScope();
+
+  if (args.Length() == 0 || !args[0]->IsNumber()) {
+    return NanThrowError("Number level is required.");
+  }
+
+  git_trace_level_t level = (git_trace_level_t)args[0]->Int32Value();
+  int result = level == GIT_TRACE_NONE
+    ? git_trace_set(GIT_TRACE_NONE, NULL)
+    : git_trace_set(level, TraceBuffer::Write);
+
+  if (result == GIT_OK) {
+    TraceBuffer::SetLevel(level);
+  }
+
+  if (result != GIT_OK) {
+    if (giterr_last()) {
+      return NanThrowError(giterr_last()->message);
+    } else {
+      return NanThrowError("Unknown Error");
+    }
+  }
+
+  NanReturnUndefined();
+}
@@ -0,0 +1,91 @@
+/*
+ * The next entries of walk under this tree, read on a worker. A count below
+ * max means the walk is over.
+ *
+ * @async
+ * @param TreeWalk walk
+ * @param Number max
+ * @return Object columns
+ */
+NAN_METHOD(GitTree::WalkNext) {
+  return WalkNextWorker::Dispatch(args, 2, WalkNextStart);
+}
+
+NAN_METHOD(GitTree::WalkNextStart) {
+  NanScope();
+
+  TreeWalk *walk = args.Length() > 0 ? TreeWalk::FromValue(args[0]) : NULL;
+
+  if (walk == NULL) {
+    return NanThrowError("TreeWalk walk is required.");
+  }
+
+  if (args.Length() == 1 || !args[1]->IsNumber() || args[1]->NumberValue() < 1) {
+    return NanThrowError("Number max is required.");
+  }
+
+  GitTree *tree = ObjectWrap::Unwrap<GitTree>(args.This());
+
+  if (tree->GetValue() == NULL) {
+    return NanThrowError("Tree has already been freed.");
+  }
+
+  static Stats::Function *bindingStats = Stats::Register("Tree.walkNext");
+  CancelToken *cancelToken;
+
+  WalkNextWorker *worker = WalkNextWorker::Begin(args, 2, bindingStats,
+    tree->scope, &cancelToken);
+
+  if (worker == NULL) {
+    NanReturnUndefined();
+  }
+
+  WalkNextBaton *baton = ObjectPool<WalkNextBaton>::Acquire();
+
+  baton->error_code = GIT_OK;
+  baton->error = NULL;
+  baton->tree = tree->GetValue();
+  baton->walk = walk;
+  baton->max = (size_t)args[1]->NumberValue();
+
+  baton->out = new TreeWalkBatch();
+
+  worker->baton = baton;
+  worker->KeepAlive(args.This());
+  worker->KeepAlive(args[0]);
+
+  // Steps the walk, which another call could be stepping at the same time,
+  // so it takes the repository like a writer.
+  worker->Queue(ThreadPool::INTERACTIVE, git_tree_owner(baton->tree),
+    ThreadPool::WRITE, cancelToken);
+  NanReturnUndefined();
+}
+
+void GitTree::WalkNextWorker::Execute() {
+  if (IsCancelledBeforeStart(baton)) {
+    return;
+  }
+
+  int result = baton->walk->Next(baton->out, baton->tree, baton->max);
+
+  SetResult(baton, result);
+}
+
+void GitTree::WalkNextWorker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  TryCatch try_catch;
+
+  if (baton->error_code == GIT_OK) {
+    Resolve(baton->out->ToColumns());
+  } else {
+    RejectBaton(baton);
+  }
+
+  if (try_catch.HasCaught()) {
+    node::FatalException(try_catch);
+  }
+
+  delete baton->out;
+  baton->arena.Reset();
+  ObjectPool<WalkNextBaton>::Release(baton);
+}
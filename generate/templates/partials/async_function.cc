@@ -1,17 +1,73 @@
 
 {%partial doc .%}
 NAN_METHOD({{ cppClassName }}::{{ cppFunctionName }}) {
+  // With a callback (after an optional CancelToken) the call is node style.
+  if ((args.Length() > {{args|jsArgsCount}} && args[{{args|jsArgsCount}}]->IsFunction())
+      || (args.Length() > {{args|jsArgsCount}} + 1 && args[{{args|jsArgsCount}} + 1]->IsFunction())) {
+    return {{ cppFunctionName }}Start(args);
+  }
+
+  if (!PromiseFactory::IsAvailable()) {
+    return NanThrowError("Callback is required and must be a Function.");
+  }
+
+  // Otherwise it returns a promise, which anything thrown while starting the
+  // call rejects.
+  NanScope();
+  Local<Object> promise = PromiseFactory::Push();
+  TryCatch tryCatch;
+
+  {{ cppFunctionName }}Start(args);
+
+  if (tryCatch.HasCaught()) {
+    Local<Function> resolve;
+    Local<Function> reject;
+    Handle<v8::Value> argv[1] = { tryCatch.Exception() };
+
+    PromiseFactory::Pop(&resolve, &reject);
+    reject->Call(NanGetCurrentContext()->Global(), 1, argv);
+  }
+
+  NanReturnValue(promise);
+}
+
+NAN_METHOD({{ cppClassName }}::{{ cppFunctionName }}Start) {
   NanScope();
   {%partial guardArguments .%}
-  if (args.Length() == {{args|jsArgsCount}} || !args[{{args|jsArgsCount}}]->IsFunction()) {
-    return NanThrowError("Callback is required and must be a Function.");
+  {%partial callScope .%}
+  // The CancelToken is last when there is no callback.
+  Handle<v8::Value> callback = NanUndefined();
+  Handle<v8::Value> cancelTokenArg = NanUndefined();
+
+  if (args.Length() > {{args|jsArgsCount}} && args[{{args|jsArgsCount}}]->IsFunction()) {
+    callback = args[{{args|jsArgsCount}}];
+  }
+  else {
+    if (args.Length() > {{args|jsArgsCount}}) {
+      cancelTokenArg = args[{{args|jsArgsCount}}];
+    }
+    if (args.Length() > {{args|jsArgsCount}} + 1) {
+      callback = args[{{args|jsArgsCount}} + 1];
+    }
+  }
+
+  CancelToken *cancelToken = NULL;
+  if (!cancelTokenArg->IsUndefined() && !cancelTokenArg->IsNull()) {
+    cancelToken = CancelToken::FromValue(cancelTokenArg);
+
+    if (cancelToken == NULL) {
+      return NanThrowError("Cancel token must be a CancelToken.");
+    }
   }
 
-  {{ cppFunctionName }}Baton* baton = new {{ cppFunctionName }}Baton;
+  {{ cppFunctionName }}Baton* baton = ObjectPool<{{ cppFunctionName }}Baton>::Acquire();
 
   baton->error_code = GIT_OK;
   baton->error = NULL;
 
+  // Converted arguments live as long as the baton.
+  ArgumentArena &arena = baton->arena;
+
   {%each args|argsInfo as arg %}
     {%if arg.globalPayload %}
   {{ cppFunctionName }}_globalPayload* globalPayload = new {{ cppFunctionName }}_globalPayload;
@@ -35,6 +91,16 @@ NAN_METHOD({{ cppClassName }}::{{ cppFunctionName }}) {
     baton->{{ arg.name}} = {{ cppFunctionName }}_{{ arg.name }}_cppCallback;
         {%if arg.payload.globalPayload %}
     globalPayload->{{ arg.name }} = new NanCallback(args[{{ arg.jsArg }}].As<Function>());
+          {%if arg.batch %}
+    globalPayload->{{ arg.name }}Batch = CallbackBatch::FromFunction(
+      args[{{ arg.jsArg }}].As<Function>(),
+      globalPayload->{{ arg.name }},
+      {{ cppFunctionName }}_{{ arg.name }}_releaseBatchEntry,
+      {{ arg.batch.size }},
+      {{ arg.batch.wait }},
+      {{ arg.batch.coalesce }}
+    );
+          {%endif%}
         {%else%}
     baton->{{ arg.payload.name }} = new NanCallback(args[{{ arg.jsArg }}].As<Function>());
         {%endif%}
@@ -47,9 +113,6 @@ NAN_METHOD({{ cppClassName }}::{{ cppFunctionName }}) {
   {%partial convertFromV8 arg%}
         {%if not arg.payloadFor %}
   baton->{{ arg.name }} = from_{{ arg.name }};
-          {%if arg | isOid %}
-  baton->{{ arg.name }}NeedsFree = args[{{ arg.jsArg }}]->IsString();
-          {%endif%}
         {%endif%}
       {%endif%}
     {%elsif arg.shouldAlloc %}
@@ -57,28 +120,79 @@ NAN_METHOD({{ cppClassName }}::{{ cppFunctionName }}) {
     {%endif%}
   {%endeach%}
 
-  NanCallback *callback = new NanCallback(Local<Function>::Cast(args[{{args|jsArgsCount}}]));
-  {{ cppFunctionName }}Worker *worker = new {{ cppFunctionName }}Worker(baton, callback);
+  static Stats::Function *bindingStats = Stats::Register("{{ jsClassName }}.{{ jsFunctionName }}");
+
+  {{ cppFunctionName }}Worker *worker = {{ cppFunctionName }}Worker::Acquire(callback);
+  worker->baton = baton;
+  worker->TrackStats(bindingStats);
+  worker->JoinScope(callScope, callScopes.Others());
+
+  // Only wrapped objects need keeping alive; everything else was copied.
   {%each args|argsInfo as arg %}
     {%if not arg.isReturn %}
       {%if arg.isSelf %}
-  worker->SaveToPersistent("{{ arg.name }}", args.This());
+  worker->KeepAlive(args.This());
       {%elsif not arg.isCallbackFunction %}
-  if (!args[{{ arg.jsArg }}]->IsUndefined() && !args[{{ arg.jsArg }}]->IsNull())
-    worker->SaveToPersistent("{{ arg.name }}", args[{{ arg.jsArg }}]->ToObject());
+  if (args[{{ arg.jsArg }}]->IsObject())
+    worker->KeepAlive(args[{{ arg.jsArg }}]);
       {%endif%}
     {%endif%}
   {%endeach%}
+  if (cancelToken) {
+    worker->KeepAlive(cancelTokenArg);
+  }
+
+  {%if cacheLookup %}
+  // An object libgit2 has already parsed is handed back right away instead
+  // of taking a trip through the thread pool. Objects never change, so this
+  // can't be affected by writes queued on the repository.
+  if ((cancelToken == NULL || !cancelToken->IsCancelled())
+      && nodegit_object_cache_lookup(
+    {%each args|argsInfo as arg %}
+      {%if arg.isReturn %}
+        (git_object **)&baton->{{ arg.name }},
+      {%else%}
+        baton->{{ arg.name }},
+      {%endif%}
+    {%endeach%}
+        {{ cacheLookup }}) == GIT_OK) {
+    worker->Finish();
+    NanReturnUndefined();
+  }
 
-  NanAsyncQueueWorker(worker);
+  {%endif%}
+  ThreadPool::QueueWork(
+    worker,
+    {%if priority == "bulk" %}ThreadPool::BULK{%else%}ThreadPool::INTERACTIVE{%endif%},
+    {%if repoKey %}
+      {%if repoKey.ownerFunction %}
+    {{ repoKey.ownerFunction }}(baton->{{ repoKey.name }}),
+      {%else%}
+    baton->{{ repoKey.name }},
+      {%endif%}
+    {%else%}
+    NULL,
+    {%endif%}
+    {%if repoAccess == "write" %}ThreadPool::WRITE{%else%}ThreadPool::READ{%endif%},
+    cancelToken,
+    worker->GetTiming()
+  );
   NanReturnUndefined();
 }
 
 void {{ cppClassName }}::{{ cppFunctionName }}Worker::Execute() {
+  // Cancelled while it was still queued, so don't start it at all.
+  if (CancelToken::IsCurrentCancelled()) {
+    CancelToken::SetCancelledError();
+    baton->error_code = GIT_EUSER;
+    baton->error = git_error_dup(giterr_last());
+    return;
+  }
+
   {%if .|hasReturnType %}
-  {{ return.cType }} result = {{ cFunctionName }}(
+  {{ return.cType }} result = {{ callInstead|or cFunctionName }}(
   {%else%}
-  {{ cFunctionName }}(
+  {{ callInstead|or cFunctionName }}(
   {%endif%}
     {%-- Insert Function Arguments --%}
     {%each args|argsInfo as arg %}
@@ -91,6 +205,11 @@ void {{ cppClassName }}::{{ cppFunctionName }}Worker::Execute() {
   {%if return.isErrorCode %}
   baton->error_code = result;
 
+  // Report a cancellation instead of whatever libgit2 made of our GIT_EUSER.
+  if (result != GIT_OK && CancelToken::IsCurrentCancelled()) {
+    CancelToken::SetCancelledError();
+  }
+
   if (result != GIT_OK && giterr_last() != NULL) {
     baton->error = git_error_dup(giterr_last());
   }
@@ -100,9 +219,25 @@ void {{ cppClassName }}::{{ cppFunctionName }}Worker::Execute() {
   baton->result = result;
 
   {%endif%}
+
+  {%each args|argsInfo as arg %}
+    {%if arg.isCallbackFunction %}
+      {%if arg.batch %}
+        {%if arg.payload.globalPayload %}
+  // Hand over whatever is still buffered before the operation completes.
+  if (baton->{{ arg.payload.name }} != NULL
+      && (({{ cppFunctionName }}_globalPayload*)baton->{{ arg.payload.name }})->{{ arg.name }}Batch != NULL) {
+    (({{ cppFunctionName }}_globalPayload*)baton->{{ arg.payload.name }})->{{ arg.name }}Batch->Flush({{ cppFunctionName }}_{{ arg.name }}_asyncBatch);
+  }
+        {%endif%}
+      {%endif%}
+    {%endif%}
+  {%endeach%}
 }
 
 void {{ cppClassName }}::{{ cppFunctionName }}Worker::HandleOKCallback() {
+  Stats::CompletionTimer bindingTimer(stats, GetTiming());
+  Scope::Creating creating(scope);
   TryCatch try_catch;
 
   if (baton->error_code == GIT_OK) {
@@ -123,43 +258,18 @@ void {{ cppClassName }}::{{ cppFunctionName }}Worker::HandleOKCallback() {
     Handle<v8::Value> result = to;
       {%endif%}
     {%endif%}
-    Handle<v8::Value> argv[2] = {
-      NanNull(),
-      result
-    };
-    callback->Call(2, argv);
+    creating.End();
+    Resolve(result);
   } else {
+    creating.End();
     if (baton->error) {
-      Handle<v8::Value> argv[1] = {
-        NanError(baton->error->message)
-      };
-      callback->Call(1, argv);
+      Reject(NanError(baton->error->message));
       if (baton->error->message)
         free((void *)baton->error->message);
       free((void *)baton->error);
     } else {
-      callback->Call(0, NULL);
+      Resolve(NanUndefined());
     }
-
-    {%each args|argsInfo as arg %}
-      {%if arg.shouldAlloc %}
-        {%if not arg.isCppClassStringOrArray %}
-        {%elsif arg | isOid %}
-    if (baton->{{ arg.name}}NeedsFree) {
-      baton->{{ arg.name}}NeedsFree = false;
-      free((void*)baton->{{ arg.name }});
-    }
-        {%elsif arg.isCallbackFunction %}
-          {%if not arg.payload.globalPayload %}
-    delete baton->{{ arg.payload.name }};
-          {%endif%}
-        {%elsif arg.globalPayload %}
-    delete ({{ cppFunctionName}}_globalPayload*)baton->{{ arg.name }};
-        {%else%}
-    free((void*)baton->{{ arg.name }});
-        {%endif%}
-      {%endif%}
-    {%endeach%}
   }
 
   if (try_catch.HasCaught()) {
@@ -168,16 +278,14 @@ void {{ cppClassName }}::{{ cppFunctionName }}Worker::HandleOKCallback() {
 
   {%each args|argsInfo as arg %}
     {%if arg.isCppClassStringOrArray %}
-      {%if arg.freeFunctionName %}
+      {%-- inputs belong to baton->arena, only results need freeing --%}
+      {%if arg.isReturn %}
+        {%if arg.freeFunctionName %}
   {{ arg.freeFunctionName }}(baton->{{ arg.name }});
-      {%else%}
+        {%else%}
   free((void *)baton->{{ arg.name }});
+        {%endif%}
       {%endif%}
-    {%elsif arg | isOid %}
-  if (baton->{{ arg.name}}NeedsFree) {
-    baton->{{ arg.name}}NeedsFree = false;
-    free((void *)baton->{{ arg.name }});
-  }
     {%elsif arg.isCallbackFunction %}
       {%if not arg.payload.globalPayload %}
   delete baton->{{ arg.payload.name }};
@@ -187,7 +295,8 @@ void {{ cppClassName }}::{{ cppFunctionName }}Worker::HandleOKCallback() {
     {%endif%}
   {%endeach%}
 
-  delete baton;
+  baton->arena.Reset();
+  ObjectPool<{{ cppFunctionName }}Baton>::Release(baton);
 }
 
 {%partial callbackHelpers .%}
@@ -0,0 +1,23 @@
+  // Wrappers made by this call join the scope of what it was called on or
+  // passed, or else the scope being run.
+  Scope::CallScopes callScopes;
+{%each args|argsInfo as arg %}
+  {%if arg.isSelf %}
+    {%if cppFunctionName != "Free" %}
+  if (ObjectWrap::Unwrap<{{ arg.cppClassName }}>(args.This())->GetValue() == NULL) {
+    return NanThrowError("{{ arg.jsClassName }} has already been freed.");
+  }
+    {%endif%}
+  callScopes.Add(ObjectWrap::Unwrap<{{ arg.cppClassName }}>(args.This())->scope);
+  {%elsif arg.joinsScope %}
+  if (args.Length() > {{ arg.jsArg }} && args[{{ arg.jsArg }}]->IsObject()) {
+    {{ arg.cppClassName }} *{{ arg.name }}Wrapper = ObjectWrap::Unwrap<{{ arg.cppClassName }}>(args[{{ arg.jsArg }}]->ToObject());
+
+    if ({{ arg.name }}Wrapper->GetValue() == NULL) {
+      return NanThrowError("{{ arg.jsClassName }} {{ arg.name }} has already been freed.");
+    }
+    callScopes.Add({{ arg.name }}Wrapper->scope);
+  }
+  {%endif%}
+{%endeach%}
+  Scope *callScope = callScopes.First() ? callScopes.First() : Scope::Current();
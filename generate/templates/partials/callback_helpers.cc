@@ -6,6 +6,45 @@
     {{ arg.cType }} {{ arg.name}}{% if not arg.lastArg %},{% endif %}
   {% endeach %}
 ) {
+  {% if cbFunction.return.type == "int" %}
+  if (CancelToken::IsCurrentCancelled()) {
+    return GIT_EUSER;
+  }
+
+  {% endif %}
+  {% if cbFunction.batch %}
+    {% if cbFunction.payload.globalPayload %}
+  CallbackBatch *batch = (({{ cppFunctionName }}_globalPayload*)payload)->{{ cbFunction.name }}Batch;
+
+  if (batch) {
+    // The entry outlives this call, so anything libgit2 only lends us for
+    // its duration gets copied.
+    {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* entry = new {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton();
+
+    {% each cbFunction.args|argsInfo as arg %}
+      {% if arg | isPayload %}
+    entry->{{ arg.name }} = {{ arg.name }};
+      {% elsif arg.cType == "const char *" %}
+    entry->{{ arg.name }} = {{ arg.name }} == NULL ? NULL : strdup({{ arg.name }});
+      {% elsif arg.copy %}
+    entry->{{ arg.name }} = {{ arg.name }} == NULL ? NULL : {{ arg.copy }}({{ arg.name }});
+      {% elsif arg.cType|isPointer %}
+    entry->{{ arg.name }} = NULL;
+    if ({{ arg.name }} != NULL) {
+      void *copy = malloc(sizeof(*{{ arg.name }}));
+      memcpy(copy, {{ arg.name }}, sizeof(*{{ arg.name }}));
+      entry->{{ arg.name }} = ({{ arg.cType }})copy;
+    }
+      {% else %}
+    entry->{{ arg.name }} = {{ arg.name }};
+      {% endif %}
+    {% endeach %}
+
+    return batch->Push(entry, {{ cppFunctionName }}_{{ cbFunction.name }}_asyncBatch);
+  }
+
+    {% endif %}
+  {% endif %}
   {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* baton = new {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton();
 
   {% each cbFunction.args|argsInfo as arg %}
@@ -13,15 +52,16 @@
   {% endeach %}
 
   baton->result = 0;
-  baton->req.data = baton;
   baton->done = false;
+  uv_sem_init(&baton->semaphore, 0);
 
-  uv_async_init(uv_default_loop(), &baton->req, (uv_async_cb) {{ cppFunctionName }}_{{ cbFunction.name }}_async);
-  uv_async_send(&baton->req);
+  {
+    ThreadPool::CallbackWait callbackWait;
 
-  while(!baton->done) {
-    this_thread::sleep_for(chrono::milliseconds(1));
+    CallbackDispatcher::Enqueue({{ cppFunctionName }}_{{ cbFunction.name }}_async, baton);
+    uv_sem_wait(&baton->semaphore);
   }
+  uv_sem_destroy(&baton->semaphore);
 
   {% each cbFunction|returnsInfo false true as _return %}
     {% if _return.isOutParam %}
@@ -29,13 +69,16 @@
     {% endif %}
   {% endeach %}
 
-  return baton->result;
+  {{ cbFunction.return.type }} result = baton->result;
+  delete baton;
+
+  return result;
 }
 
-void {{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_async(uv_async_t* req, int status) {
+void {{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_async(void *data) {
   NanScope();
 
-  {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* baton = static_cast<{{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton*>(req->data);
+  {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* baton = static_cast<{{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton*>(data);
 
   {% each cbFunction.args|argsInfo as arg %}
     {% if arg | isPayload %}
@@ -75,14 +118,15 @@ void {{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_async(uv_as
     Handle<v8::Value> thenProp = result->ToObject()->Get(NanNew("then"));
 
     if (thenProp->IsFunction()) {
-      // we can be reasonbly certain that the result is a promise
-      Local<Object> promise = result->ToObject();
-
-      NanAssignPersistent(baton->promise, promise);
-
-      uv_close((uv_handle_t*) &baton->req, NULL);
-      uv_async_init(uv_default_loop(), &baton->req, (uv_async_cb) {{ cppFunctionName }}_{{ cbFunction.name }}_asyncPromisePolling);
-      uv_async_send(&baton->req);
+      // we can be reasonbly certain that the result is a promise, so let it
+      // complete the baton once it settles instead of polling it
+      PromiseFactory::Then(
+        result->ToObject(),
+        thenProp.As<Function>(),
+        {{ cppFunctionName }}_{{ cbFunction.name }}_promiseFulfilled,
+        {{ cppFunctionName }}_{{ cbFunction.name }}_promiseRejected,
+        baton
+      );
       return;
     }
   }
@@ -113,63 +157,161 @@ void {{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_async(uv_as
   {% endeach %}
 
   baton->done = true;
-  uv_close((uv_handle_t*) &baton->req, NULL);
+  uv_sem_post(&baton->semaphore);
 }
 
-void {{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_asyncPromisePolling(uv_async_t* req, int status) {
+NAN_METHOD({{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_promiseFulfilled) {
   NanScope();
 
-  {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* baton = static_cast<{{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton*>(req->data);
-  Local<Object> promise = NanNew<Object>(baton->promise);
-  NanCallback* isPendingFn = new NanCallback(promise->Get(NanNew("isPending")).As<Function>());
-  Local<Value> argv[1]; // MSBUILD won't assign an array of length 0
-  Local<Boolean> isPending = isPendingFn->Call(promise, 0, argv)->ToBoolean();
+  void *data = PromiseFactory::TakeBaton(args.This());
 
-  if (isPending->Value()) {
-    uv_async_send(&baton->req);
-    return;
+  if (data == NULL) {
+    NanReturnUndefined();
   }
 
-  NanCallback* isFulfilledFn = new NanCallback(promise->Get(NanNew("isFulfilled")).As<Function>());
-  Local<Boolean> isFulfilled = isFulfilledFn->Call(promise, 0, argv)->ToBoolean();
-
-  if (isFulfilled->Value()) {
-    NanCallback* resultFn = new NanCallback(promise->Get(NanNew("value")).As<Function>());
-    Handle<v8::Value> result = resultFn->Call(promise, 0, argv);
+  {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* baton = static_cast<{{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton*>(data);
+  Handle<v8::Value> result = args[0];
 
-    {% each cbFunction|returnsInfo false true as _return %}
-      if (result.IsEmpty() || result->IsNativeError()) {
-        baton->result = {{ cbFunction.return.error }};
-      }
-      else if (!result->IsNull() && !result->IsUndefined()) {
-        {% if _return.isOutParam %}
-        {{ _return.cppClassName }}* wrapper = ObjectWrap::Unwrap<{{ _return.cppClassName }}>(result->ToObject());
-        wrapper->selfFreeing = false;
+  {% each cbFunction|returnsInfo false true as _return %}
+    if (result.IsEmpty() || result->IsNativeError()) {
+      baton->result = {{ cbFunction.return.error }};
+    }
+    else if (!result->IsNull() && !result->IsUndefined()) {
+      {% if _return.isOutParam %}
+      {{ _return.cppClassName }}* wrapper = ObjectWrap::Unwrap<{{ _return.cppClassName }}>(result->ToObject());
+      wrapper->selfFreeing = false;
 
-        baton->{{ _return.name }} = wrapper->GetRefValue();
-        baton->result = {{ cbFunction.return.success }};
-        {% else %}
-        if (result->IsNumber()) {
-          baton->result = (int)result->ToNumber()->Value();
-        }
-        else {
-          baton->result = {{ cbFunction.return.noResults }};
-        }
-        {% endif %}
+      baton->{{ _return.name }} = wrapper->GetRefValue();
+      baton->result = {{ cbFunction.return.success }};
+      {% else %}
+      if (result->IsNumber()) {
+        baton->result = (int)result->ToNumber()->Value();
       }
       else {
         baton->result = {{ cbFunction.return.noResults }};
       }
+      {% endif %}
+    }
+    else {
+      baton->result = {{ cbFunction.return.noResults }};
+    }
+  {% endeach %}
+
+  baton->done = true;
+  uv_sem_post(&baton->semaphore);
+
+  NanReturnUndefined();
+}
+
+NAN_METHOD({{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_promiseRejected) {
+  NanScope();
+
+  void *data = PromiseFactory::TakeBaton(args.This());
+
+  if (data == NULL) {
+    NanReturnUndefined();
+  }
+
+  {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* baton = static_cast<{{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton*>(data);
+
+  baton->result = {{ cbFunction.return.error }};
+  baton->done = true;
+  uv_sem_post(&baton->semaphore);
+
+  NanReturnUndefined();
+}
+
+    {% if cbFunction.batch %}
+      {% if cbFunction.payload.globalPayload %}
+void {{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_asyncBatch(void *data) {
+  NanScope();
+
+  CallbackBatch *batch = static_cast<CallbackBatch *>(data);
+  std::vector<void *> entries = batch->Take();
+
+  // Its owner let go of it while this was queued.
+  if (batch->callback == NULL) {
+    batch->Delivered(entries, {{ cbFunction.return.success }});
+    return;
+  }
+
+  Local<Array> items = NanNew<Array>(entries.size());
+
+  for (unsigned int i = 0; i < entries.size(); i++) {
+    {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* baton = static_cast<{{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton*>(entries[i]);
+
+    Local<Value> argv[{{ cbFunction.args|jsArgsCount }}] = {
+      {% each cbFunction.args|argsInfo as arg %}
+        {% if arg | isPayload %}
+          NanUndefined()
+        {% elsif arg.isJsArg %}
+          {% if arg.isEnum %}
+            NanNew((int)baton->{{ arg.name }}),
+          {% elsif arg.isLibgitType %}
+            NanNew({{ arg.cppClassName }}::New((void *)baton->{{ arg.name }}, true)),
+          {% elsif arg.cType == "size_t" %}
+            // HACK: NAN should really have an overload for NanNew to support size_t
+            NanNew((unsigned int)baton->{{ arg.name }}),
+          {% else %}
+            NanNew(baton->{{ arg.name }}),
+          {% endif %}
+        {% endif %}
+      {% endeach %}
+    };
+
+    // The wrappers own the copies now, and JS is free to keep them.
+    {% each cbFunction.args|argsInfo as arg %}
+      {% if not arg | isPayload %}
+        {% if arg.isJsArg %}
+          {% if not arg.isEnum %}
+            {% if arg.isLibgitType %}
+    baton->{{ arg.name }} = NULL;
+            {% endif %}
+          {% endif %}
+        {% endif %}
+      {% endif %}
     {% endeach %}
-    baton->done = true;
+
+    // payload is always the last arg and is left out of the entry
+    Local<Array> item = NanNew<Array>({{ cbFunction.args|jsArgsCount }} - 1);
+    for (unsigned int j = 0; j < {{ cbFunction.args|jsArgsCount }} - 1; j++) {
+      item->Set(j, argv[j]);
+    }
+
+    items->Set(i, item);
+  }
+
+  Local<Value> argv[1] = { items };
+
+  TryCatch tryCatch;
+  Handle<v8::Value> result = batch->callback->Call(1, argv);
+  int batchResult = {{ cbFunction.return.success }};
+
+  if (result.IsEmpty() || result->IsNativeError()) {
+    batchResult = {{ cbFunction.return.error }};
   }
-  else {
-    // promise was rejected
-    baton->result = {{ cbFunction.return.error }};
-    baton->done = false;
+  else if (result->IsNumber()) {
+    batchResult = (int)result->ToNumber()->Value();
   }
 
-  uv_close((uv_handle_t*) &baton->req, NULL);
+  batch->Delivered(entries, batchResult);
 }
+
+void {{ cppClassName }}::{{ cppFunctionName }}_{{ cbFunction.name }}_releaseBatchEntry(void *data) {
+  {{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton* entry = static_cast<{{ cppFunctionName }}_{{ cbFunction.name|titleCase }}Baton*>(data);
+
+  // Copies handed to a wrapper were cleared when the batch was delivered.
+  {% each cbFunction.args|argsInfo as arg %}
+    {% if not arg | isPayload %}
+      {% if arg.cType|isPointer %}
+  free((void *)entry->{{ arg.name }});
+      {% endif %}
+    {% endif %}
+  {% endeach %}
+
+  delete entry;
+}
+      {% endif %}
+    {% endif %}
   {%endif%}
 {%endeach%}
@@ -10,18 +10,18 @@
   {%if cppClassName == 'String'%}
 
   String::Utf8Value {{ name }}(args[{{ jsArg }}]->ToString());
-  from_{{ name }} = ({{ cType }}) strdup(*{{ name }});
+  from_{{ name }} = ({{ cType }}) arena.Strdup(*{{ name }});
   {%elsif cppClassName == 'GitStrarray' %}
 
-  from_{{ name }} = StrArrayConverter::Convert(args[{{ jsArg }}]);
+  from_{{ name }} = StrArrayConverter::Convert(args[{{ jsArg }}], arena);
   {%elsif cppClassName == 'Wrapper'%}
 
   String::Utf8Value {{ name }}(args[{{ jsArg }}]->ToString());
-  from_{{ name }} = ({{ cType }}) strdup(*{{ name }});
+  from_{{ name }} = ({{ cType }}) arena.Strdup(*{{ name }});
   {%elsif cppClassName == 'Array'%}
 
   Array *tmp_{{ name }} = Array::Cast(*args[{{ jsArg }}]);
-  from_{{ name }} = ({{ cType }})malloc(tmp_{{ name }}->Length() * sizeof({{ cType|replace '**' '*' }}));
+  from_{{ name }} = ({{ cType }})arena.Alloc(tmp_{{ name }}->Length() * sizeof({{ cType|replace '**' '*' }}));
       for (unsigned int i = 0; i < tmp_{{ name }}->Length(); i++) {
     {%--
       // FIXME: should recursively call convertFromv8.
@@ -43,11 +43,9 @@
   if (args[{{ jsArg }}]->IsString()) {
     // Try and parse in a string to a git_oid
     String::Utf8Value oidString(args[{{ jsArg }}]->ToString());
-    git_oid *oidOut = (git_oid *)malloc(sizeof(git_oid));
-
-    if (git_oid_fromstr(oidOut, (const char *) strdup(*oidString)) != GIT_OK) {
-      free(oidOut);
+    git_oid *oidOut = (git_oid *)arena.Alloc(sizeof(git_oid));
 
+    if (git_oid_fromstr(oidOut, *oidString) != GIT_OK) {
       if (giterr_last()) {
         return NanThrowError(giterr_last()->message);
       } else {
@@ -56,11 +54,22 @@
     }
 
     {%if cType|isDoublePointer %}
-    from_{{ name }} = &oidOut;
+    git_oid **oidRef = (git_oid **)arena.Alloc(sizeof(git_oid *));
+    *oidRef = oidOut;
+    from_{{ name }} = oidRef;
     {%else%}
     from_{{ name }} = oidOut;
     {%endif%}
   }
+  else if (git_oid *oidView = OidView::FromValue(args[{{ jsArg }}])) {
+    {%if cType|isDoublePointer %}
+    git_oid **oidRef = (git_oid **)arena.Alloc(sizeof(git_oid *));
+    *oidRef = oidView;
+    from_{{ name }} = oidRef;
+    {%else%}
+    from_{{ name }} = oidView;
+    {%endif%}
+  }
   else {
     {%if cType|isDoublePointer %}
     from_{{ name }} = ObjectWrap::Unwrap<{{ cppClassName }}>(args[{{ jsArg }}]->ToObject())->GetRefValue();
@@ -54,7 +54,7 @@
     {% if cppClassName == 'Wrapper' %}
       to = {{ cppClassName }}::New((void *){{= parsedName =}});
     {% else %}
-      to = {{ cppClassName }}::New((void *){{= parsedName =}}, false);
+      to = {{ cppClassName }}::New((void *){{= parsedName =}}, false{% if isOwned %}, true{% endif %});
     {% endif %}
   }
   else {
@@ -50,12 +50,29 @@
           delete wrapper->{{ field.name }};
         }
 
+        {% if field.batch %}
+        if (wrapper->{{ field.name }}Batch != NULL) {
+          wrapper->{{ field.name }}Batch->Dispose();
+          wrapper->{{ field.name }}Batch = NULL;
+        }
+        {% endif %}
+
         if (value->IsFunction()) {
           if (!wrapper->raw->{{ field.name }}) {
             wrapper->raw->{{ field.name }} = ({{ field.cType }}){{ field.name }}_cppCallback;
           }
 
           wrapper->{{ field.name }} = new NanCallback(value.As<Function>());
+          {% if field.batch %}
+          wrapper->{{ field.name }}Batch = CallbackBatch::FromFunction(
+            value.As<Function>(),
+            wrapper->{{ field.name }},
+            {{ field.name }}_releaseBatchEntry,
+            {{ field.batch.size }},
+            {{ field.batch.wait }},
+            {{ field.batch.coalesce }}
+          );
+          {% endif %}
         }
 
       {% elsif field.payloadFor %}
@@ -86,6 +103,43 @@
           {{ arg.cType }} {{ arg.name}}{% if not arg.lastArg %},{% endif %}
         {% endeach %}
       ) {
+        {% if field.return.type == "int" %}
+        if (CancelToken::IsCurrentCancelled()) {
+          return GIT_EUSER;
+        }
+
+        {% endif %}
+        {% if field.batch %}
+        {{ cppClassName }}* instance = static_cast<{{ cppClassName }}*>(payload);
+
+        if (instance->{{ field.name }}Batch) {
+          // The entry outlives this call, so anything libgit2 only lends us
+          // for its duration gets copied.
+          {{ field.name|titleCase }}Baton* entry = new {{ field.name|titleCase }}Baton();
+
+          {% each field.args|argsInfo as arg %}
+            {% if arg.name == "payload" %}
+          entry->{{ arg.name }} = {{ arg.name }};
+            {% elsif arg.cType == "const char *" %}
+          entry->{{ arg.name }} = {{ arg.name }} == NULL ? NULL : strdup({{ arg.name }});
+            {% elsif arg.copy %}
+          entry->{{ arg.name }} = {{ arg.name }} == NULL ? NULL : {{ arg.copy }}({{ arg.name }});
+          {% elsif arg.cType|isPointer %}
+          entry->{{ arg.name }} = NULL;
+          if ({{ arg.name }} != NULL) {
+            void *copy = malloc(sizeof(*{{ arg.name }}));
+            memcpy(copy, {{ arg.name }}, sizeof(*{{ arg.name }}));
+            entry->{{ arg.name }} = ({{ arg.cType }})copy;
+          }
+            {% else %}
+          entry->{{ arg.name }} = {{ arg.name }};
+            {% endif %}
+          {% endeach %}
+
+          return instance->{{ field.name }}Batch->Push(entry, {{ field.name }}_asyncBatch);
+        }
+
+        {% endif %}
         {{ field.name|titleCase }}Baton* baton = new {{ field.name|titleCase }}Baton();
 
         {% each field.args|argsInfo as arg %}
@@ -93,15 +147,16 @@
         {% endeach %}
 
         baton->result = 0;
-        baton->req.data = baton;
         baton->done = false;
+        uv_sem_init(&baton->semaphore, 0);
 
-        uv_async_init(uv_default_loop(), &baton->req, (uv_async_cb) {{ field.name }}_async);
-        uv_async_send(&baton->req);
+        {
+          ThreadPool::CallbackWait callbackWait;
 
-        while(!baton->done) {
-          this_thread::sleep_for(chrono::milliseconds(1));
+          CallbackDispatcher::Enqueue({{ field.name }}_async, baton);
+          uv_sem_wait(&baton->semaphore);
         }
+        uv_sem_destroy(&baton->semaphore);
 
         {% each field|returnsInfo false true as _return %}
           {% if _return.isOutParam %}
@@ -109,13 +164,16 @@
           {% endif %}
         {% endeach %}
 
-        return baton->result;
+        {{ field.return.type }} result = baton->result;
+        delete baton;
+
+        return result;
       }
 
-      void {{ cppClassName }}::{{ field.name }}_async(uv_async_t* req, int status) {
+      void {{ cppClassName }}::{{ field.name }}_async(void *data) {
         NanScope();
 
-        {{ field.name|titleCase }}Baton* baton = static_cast<{{ field.name|titleCase }}Baton*>(req->data);
+        {{ field.name|titleCase }}Baton* baton = static_cast<{{ field.name|titleCase }}Baton*>(data);
         {{ cppClassName }}* instance = static_cast<{{ cppClassName }}*>(baton->payload);
 
         if (instance->{{ field.name }}->IsEmpty()) {
@@ -124,6 +182,7 @@
           {% endif %}
 
           baton->done = true;
+          uv_sem_post(&baton->semaphore);
           return;
         }
 
@@ -168,14 +227,15 @@
           Handle<v8::Value> thenProp = result->ToObject()->Get(NanNew("then"));
 
           if (thenProp->IsFunction()) {
-            // we can be reasonbly certain that the result is a promise
-            Local<Object> promise = result->ToObject();
-
-            NanAssignPersistent(baton->promise, promise);
-
-            uv_close((uv_handle_t*) &baton->req, NULL);
-            uv_async_init(uv_default_loop(), &baton->req, (uv_async_cb) {{ field.name }}_asyncPromisePolling);
-            uv_async_send(&baton->req);
+            // we can be reasonbly certain that the result is a promise, so let
+            // it complete the baton once it settles instead of polling it
+            PromiseFactory::Then(
+              result->ToObject(),
+              thenProp.As<Function>(),
+              {{ field.name }}_promiseFulfilled,
+              {{ field.name }}_promiseRejected,
+              baton
+            );
             return;
           }
         }
@@ -205,64 +265,160 @@
           }
         {% endeach %}
         baton->done = true;
-        uv_close((uv_handle_t*) &baton->req, NULL);
+        uv_sem_post(&baton->semaphore);
       }
 
-      void {{ cppClassName }}::{{ field.name }}_asyncPromisePolling(uv_async_t* req, int status) {
+      NAN_METHOD({{ cppClassName }}::{{ field.name }}_promiseFulfilled) {
         NanScope();
 
-        {{ field.name|titleCase }}Baton* baton = static_cast<{{ field.name|titleCase }}Baton*>(req->data);
-        Local<Object> promise = NanNew<Object>(baton->promise);
-        NanCallback* isPendingFn = new NanCallback(promise->Get(NanNew("isPending")).As<Function>());
-        Local<Value> argv[1]; // MSBUILD won't assign an array of length 0
-        Local<Boolean> isPending = isPendingFn->Call(promise, 0, argv)->ToBoolean();
+        void *data = PromiseFactory::TakeBaton(args.This());
 
-        if (isPending->Value()) {
-          uv_async_send(&baton->req);
-          return;
+        if (data == NULL) {
+          NanReturnUndefined();
         }
 
-        NanCallback* isFulfilledFn = new NanCallback(promise->Get(NanNew("isFulfilled")).As<Function>());
-        Local<Boolean> isFulfilled = isFulfilledFn->Call(promise, 0, argv)->ToBoolean();
+        {{ field.name|titleCase }}Baton* baton = static_cast<{{ field.name|titleCase }}Baton*>(data);
+        Handle<v8::Value> result = args[0];
 
-        if (isFulfilled->Value()) {
-          NanCallback* resultFn = new NanCallback(promise->Get(NanNew("value")).As<Function>());
-          Handle<v8::Value> result = resultFn->Call(promise, 0, argv);
-
-          {% each field|returnsInfo false true as _return %}
-            if (result.IsEmpty() || result->IsNativeError()) {
-              baton->result = {{ field.return.error }};
-            }
-            else if (!result->IsNull() && !result->IsUndefined()) {
-              {% if _return.isOutParam %}
-              {{ _return.cppClassName }}* wrapper = ObjectWrap::Unwrap<{{ _return.cppClassName }}>(result->ToObject());
-              wrapper->selfFreeing = false;
+        {% each field|returnsInfo false true as _return %}
+          if (result.IsEmpty() || result->IsNativeError()) {
+            baton->result = {{ field.return.error }};
+          }
+          else if (!result->IsNull() && !result->IsUndefined()) {
+            {% if _return.isOutParam %}
+            {{ _return.cppClassName }}* wrapper = ObjectWrap::Unwrap<{{ _return.cppClassName }}>(result->ToObject());
+            wrapper->selfFreeing = false;
 
-              baton->{{ _return.name }} = wrapper->GetRefValue();
-              baton->result = {{ field.return.success }};
-              {% else %}
-              if (result->IsNumber()) {
-                baton->result = (int)result->ToNumber()->Value();
-              }
-              else{
-                baton->result = {{ field.return.noResults }};
-              }
-              {% endif %}
+            baton->{{ _return.name }} = wrapper->GetRefValue();
+            baton->result = {{ field.return.success }};
+            {% else %}
+            if (result->IsNumber()) {
+              baton->result = (int)result->ToNumber()->Value();
             }
-            else {
+            else{
               baton->result = {{ field.return.noResults }};
             }
+            {% endif %}
+          }
+          else {
+            baton->result = {{ field.return.noResults }};
+          }
+        {% endeach %}
+
+        baton->done = true;
+        uv_sem_post(&baton->semaphore);
+
+        NanReturnUndefined();
+      }
+
+      NAN_METHOD({{ cppClassName }}::{{ field.name }}_promiseRejected) {
+        NanScope();
+
+        void *data = PromiseFactory::TakeBaton(args.This());
+
+        if (data == NULL) {
+          NanReturnUndefined();
+        }
+
+        {{ field.name|titleCase }}Baton* baton = static_cast<{{ field.name|titleCase }}Baton*>(data);
+
+        baton->result = {{ field.return.error }};
+        baton->done = true;
+        uv_sem_post(&baton->semaphore);
+
+        NanReturnUndefined();
+      }
+
+      {% if field.batch %}
+      void {{ cppClassName }}::{{ field.name }}_asyncBatch(void *data) {
+        NanScope();
+
+        CallbackBatch *batch = static_cast<CallbackBatch *>(data);
+        std::vector<void *> entries = batch->Take();
+
+        // Its owner let go of it while this was queued.
+        if (batch->callback == NULL) {
+          batch->Delivered(entries, {{ field.return.success }});
+          return;
+        }
+
+        Local<Array> items = NanNew<Array>(entries.size());
+
+        for (unsigned int i = 0; i < entries.size(); i++) {
+          {{ field.name|titleCase }}Baton* baton = static_cast<{{ field.name|titleCase }}Baton*>(entries[i]);
+
+          Local<Value> argv[{{ field.args|jsArgsCount }}] = {
+            {% each field.args|argsInfo as arg %}
+              {% if arg.name == "payload" %}
+                NanUndefined()
+              {% elsif arg.isJsArg %}
+                {% if arg.isEnum %}
+                  NanNew((int)baton->{{ arg.name }}),
+                {% elsif arg.isLibgitType %}
+                  NanNew({{ arg.cppClassName }}::New((void *)baton->{{ arg.name }}, true)),
+                {% elsif arg.cType == "size_t" %}
+                  // HACK: NAN should really have an overload for NanNew to support size_t
+                  NanNew((unsigned int)baton->{{ arg.name }}),
+                {% else %}
+                  NanNew(baton->{{ arg.name }}),
+                {% endif %}
+              {% endif %}
+            {% endeach %}
+          };
+
+          // The wrappers own the copies now, and JS is free to keep them.
+          {% each field.args|argsInfo as arg %}
+            {% if arg.name != "payload" %}
+              {% if arg.isJsArg %}
+                {% if not arg.isEnum %}
+                  {% if arg.isLibgitType %}
+          baton->{{ arg.name }} = NULL;
+                  {% endif %}
+                {% endif %}
+              {% endif %}
+            {% endif %}
           {% endeach %}
-          baton->done = true;
+
+          // payload is always the last arg and is left out of the entry
+          Local<Array> item = NanNew<Array>({{ field.args|jsArgsCount }} - 1);
+          for (unsigned int j = 0; j < {{ field.args|jsArgsCount }} - 1; j++) {
+            item->Set(j, argv[j]);
+          }
+
+          items->Set(i, item);
         }
-        else {
-          // promise was rejected
-          baton->result = {{ field.return.error }};
-          baton->done = false;
+
+        Local<Value> argv[1] = { items };
+
+        TryCatch tryCatch;
+        Handle<v8::Value> result = batch->callback->Call(1, argv);
+        int batchResult = {{ field.return.success }};
+
+        if (result.IsEmpty() || result->IsNativeError()) {
+          batchResult = {{ field.return.error }};
+        }
+        else if (result->IsNumber()) {
+          batchResult = (int)result->ToNumber()->Value();
         }
 
-        uv_close((uv_handle_t*) &baton->req, NULL);
+        batch->Delivered(entries, batchResult);
       }
+
+      void {{ cppClassName }}::{{ field.name }}_releaseBatchEntry(void *data) {
+        {{ field.name|titleCase }}Baton* entry = static_cast<{{ field.name|titleCase }}Baton*>(data);
+
+        // Copies handed to a wrapper were cleared when the batch was delivered.
+        {% each field.args|argsInfo as arg %}
+          {% if arg.name != "payload" %}
+            {% if arg.cType|isPointer %}
+        free((void *)entry->{{ arg.name }});
+            {% endif %}
+          {% endif %}
+        {% endeach %}
+
+        delete entry;
+      }
+      {% endif %}
     {% endif %}
   {% endif %}
 {% endeach %}
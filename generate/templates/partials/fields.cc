@@ -4,6 +4,12 @@
       NanScope();
       Handle<v8::Value> to;
 
+      if (ObjectWrap::Unwrap<{{ cppClassName }}>(args.This())->GetValue() == NULL) {
+        return NanThrowError("{{ jsClassName }} has already been freed.");
+      }
+
+      Scope::Creating creating(ObjectWrap::Unwrap<{{ cppClassName }}>(args.This())->scope);
+
       {% if field | isFixedLengthString %}
       char* {{ field.name }} = (char *)ObjectWrap::Unwrap<{{ cppClassName }}>(args.This())->GetValue()->{{ field.name }};
       {% else %}
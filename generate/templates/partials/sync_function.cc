@@ -2,7 +2,12 @@
 {%partial doc .%}
 NAN_METHOD({{ cppClassName }}::{{ cppFunctionName }}) {
   NanEscapableScope();
+  static Stats::Function *bindingStats = Stats::Register("{{ jsClassName }}.{{ jsFunctionName }}");
+  Stats::SyncTimer bindingTimer(bindingStats);
   {%partial guardArguments .%}
+  {%partial callScope .%}
+  Scope::Creating creating(callScope);
+  ArgumentArena arena;
 
   {%each .|returnsInfo 'true' as _return %}
     {%if _return.shouldAlloc %}
@@ -37,7 +42,7 @@ if (ObjectWrap::Unwrap<{{ cppClassName }}>(args.This())->GetValue() != NULL) {
 {% endif %}
 
 {%if .|hasReturnValue %}
-  {{ return.cType }} result = {%endif%}{{ cFunctionName }}(
+  {{ return.cType }} result = {%endif%}{{ callInstead|or cFunctionName }}(
   {%each args|argsInfo as arg %}
     {%if arg.isReturn %}
       {%if not arg.shouldAlloc %}&{%endif%}
@@ -58,10 +63,6 @@ from_{{ arg.name }}
   {%each args|argsInfo as arg %}
     {%if arg.shouldAlloc %}
     free({{ arg.name }});
-    {%elsif arg | isOid %}
-    if (args[{{ arg.jsArg }}]->IsString()) {
-      free({{ arg.name }});
-    }
     {%endif%}
   {%endeach%}
 
@@ -79,14 +80,6 @@ from_{{ arg.name }}
 {% endif %}
 
 
-{%each args|argsInfo as arg %}
-  {%if arg | isOid %}
-  if (args[{{ arg.jsArg }}]->IsString()) {
-    free((void *)from_{{ arg.name }});
-  }
-  {%endif%}
-{%endeach%}
-
 {%if not .|returnsCount %}
   NanReturnUndefined();
 {%else%}
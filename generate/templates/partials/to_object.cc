@@ -0,0 +1,74 @@
+{% if hasToObject %}
+// Reads every field into a plain object in one call. Nested structs become
+// nested objects and oids become hex strings.
+Handle<v8::Value> {{ cppClassName }}::ToObject({{ cType }} *raw) {
+  NanEscapableScope();
+
+  if (raw == NULL) {
+    return NanEscapeScope(NanNull());
+  }
+
+  Local<Object> result = NanNew<Object>();
+  Handle<v8::Value> to;
+
+  {% each fields|fieldsInfo as field %}
+    {% if not field.ignore %}
+  {
+      {% if field.hasToObject %}
+    to = {{ field.cppClassName }}::ToObject({% if not field.cType|isPointer %}&{% endif %}raw->{{ field.name }});
+      {% elsif field.cppClassName == 'GitOid' %}
+    const git_oid *{{ field.name }} = {% if not field.cType|isPointer %}&{% endif %}raw->{{ field.name }};
+
+    if ({{ field.name }} != NULL) {
+      char sha[GIT_OID_HEXSZ];
+      git_oid_fmt(sha, {{ field.name }});
+      to = NanNew<String>(sha, GIT_OID_HEXSZ);
+    }
+    else {
+      to = NanNull();
+    }
+      {% else %}
+        {% if field | isFixedLengthString %}
+    char* {{ field.name }} = (char *)raw->{{ field.name }};
+        {% else %}
+    {{ field.cType }}
+          {% if not field.cppClassName|isV8Value %}
+            {% if not field.cType|isPointer %}
+      *
+            {% endif %}
+          {% endif %}
+      {{ field.name }} =
+          {% if not field.cppClassName|isV8Value %}
+            {% if not field.cType|isPointer %}
+      &
+            {% endif %}
+          {% endif %}
+      raw->{{ field.name }};
+        {% endif %}
+
+        {% partial convertToV8 field %}
+      {% endif %}
+    result->Set(NanNew({{ field.cppFunctionName }}Key), to);
+  }
+    {% endif %}
+  {% endeach %}
+
+  return NanEscapeScope(result);
+}
+
+NAN_METHOD({{ cppClassName }}::JSToObject) {
+  NanScope();
+
+  if (ObjectWrap::Unwrap<{{ cppClassName }}>(args.This())->GetValue() == NULL) {
+    return NanThrowError("{{ jsClassName }} has already been freed.");
+  }
+
+  NanReturnValue(ToObject(ObjectWrap::Unwrap<{{ cppClassName }}>(args.This())->GetValue()));
+}
+
+  {% each fields as field %}
+    {% if not field.ignore %}
+Persistent<String> {{ cppClassName }}::{{ field.cppFunctionName }}Key;
+    {% endif %}
+  {% endeach %}
+{% endif %}
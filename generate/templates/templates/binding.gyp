@@ -15,9 +15,24 @@
 
       "sources": [
         "src/nodegit.cc",
+        "src/argument_arena.cc",
+        "src/callback_batch.cc",
+        "src/callback_dispatcher.cc",
+        "src/cancel_token.cc",
+        "src/commit_graph.cc",
+        "src/commit_metadata.cc",
+        "src/footprint.cc",
         "src/wrapper.cc",
         "src/functions/copy.cc",
+        "src/path_history.cc",
+        "src/promise_factory.cc",
+        "src/revwalk_filter.cc",
+        "src/scope.cc",
+        "src/stats.cc",
         "src/str_array_converter.cc",
+        "src/thread_pool.cc",
+        "src/trace_buffer.cc",
+        "src/tree_walk.cc",
         {% each %}
           {% if type != "enum" %}
             "src/{{ name }}.cc",
@@ -74,6 +89,9 @@
             "cflags": [
               "/EHsc"
             ],
+            "include_dirs": [
+              "vendor/libgit2/deps/regex"
+            ],
             "defines": [
             "_HAS_EXCEPTIONS=1"
             ]
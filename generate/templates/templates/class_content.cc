@@ -1,8 +1,6 @@
 // This is a generated file, modify: generate/templates/class_content.cc.
 #include <nan.h>
 #include <string.h>
-#include <chrono>
-#include <thread>
 
 extern "C" {
   #include <git2.h>
@@ -12,7 +10,10 @@ extern "C" {
 }
 
 #include "../include/functions/copy.h"
+#include "../include/callback_dispatcher.h"
+#include "../include/cancel_token.h"
 #include "../include/macros.h"
+#include "../include/thread_pool.h"
 #include "../include/{{ filename }}.h"
 
 {% each dependencies as dependency %}
@@ -26,17 +27,43 @@ using namespace v8;
 using namespace node;
 
 {% if cType %}
-  {{ cppClassName }}::{{ cppClassName }}({{ cType }} *raw, bool selfFreeing) {
+  {{ cppClassName }}::{{ cppClassName }}({{ cType }} *raw, bool selfFreeing, bool owned) {
     this->raw = raw;
     this->selfFreeing = selfFreeing;
+    this->owned = owned;
+
+    // Only a wrapper whose object is its own to free is charged for it.
+    Footprint::Created(footprintType);
+    this->footprint = (selfFreeing || owned) && raw != NULL ? Footprint::Of(raw) : 0;
+    Footprint::Charge(footprintType, this->footprint);
+
+    this->scope = Scope::Current();
+    this->scopeEntry = this->scope ? this->scope->Track(this, DisposeInScope) : 0;
+    if (this->scopeEntry == 0) {
+      this->scope = NULL;
+    }
   }
 
   {{ cppClassName }}::~{{ cppClassName }}() {
+    if (this->scope) {
+      this->scope->Forget(this->scopeEntry);
+    }
+
+    Footprint::Charge(footprintType, -this->footprint);
+    Footprint::Destroyed(footprintType);
+
     {% if freeFunctionName %}
       if (this->selfFreeing) {
         {{ freeFunctionName }}(this->raw);
         this->raw = NULL;
       }
+    {% else %}
+      // Without a free function the only self-freeing objects are our own
+      // malloc'd copies, such as the entries of a callback batch.
+      if (this->selfFreeing) {
+        free(this->raw);
+        this->raw = NULL;
+      }
     {% endif %}
 
     // this will cause an error if you have a non-self-freeing object that also needs
@@ -80,6 +107,20 @@ using namespace node;
       {% endif %}
     {% endeach %}
 
+    {% if hasToObject %}
+      NODE_SET_PROTOTYPE_METHOD(tpl, "toObject", JSToObject);
+      NODE_SET_PROTOTYPE_METHOD(tpl, "toJSON", JSToObject);
+
+      // Property names are made once so toObject doesn't have to.
+      {% each fields as field %}
+        {% if not field.ignore %}
+      NanAssignPersistent({{ field.cppFunctionName }}Key, NanNew<String>("{{ field.jsFunctionName }}"));
+        {% endif %}
+      {% endeach %}
+    {% endif %}
+
+    NanAssignPersistent(function_template, tpl);
+
     Local<Function> _constructor_template = tpl->GetFunction();
     NanAssignPersistent(constructor_template, _constructor_template);
     target->Set(NanNew<String>("{{ jsClassName }}"), _constructor_template);
@@ -96,16 +137,20 @@ using namespace node;
       {% endif %}
     }
 
-    {{ cppClassName }}* object = new {{ cppClassName }}(static_cast<{{ cType }} *>(Handle<External>::Cast(args[0])->Value()), args[1]->BooleanValue());
+    {{ cppClassName }}* object = new {{ cppClassName }}(static_cast<{{ cType }} *>(Handle<External>::Cast(args[0])->Value()), args[1]->BooleanValue(), args[2]->BooleanValue());
     object->Wrap(args.This());
 
     NanReturnValue(args.This());
   }
 
-  Handle<v8::Value> {{ cppClassName }}::New(void *raw, bool selfFreeing) {
+  Handle<v8::Value> {{ cppClassName }}::New(void *raw, bool selfFreeing, bool owned) {
     NanEscapableScope();
-    Handle<v8::Value> argv[2] = { NanNew<External>((void *)raw), NanNew<Boolean>(selfFreeing) };
-    return NanEscapeScope(NanNew<Function>({{ cppClassName }}::constructor_template)->NewInstance(2, argv));
+    Handle<v8::Value> argv[3] = { NanNew<External>((void *)raw), NanNew<Boolean>(selfFreeing), NanNew<Boolean>(owned) };
+    return NanEscapeScope(NanNew<Function>({{ cppClassName }}::constructor_template)->NewInstance(3, argv));
+  }
+
+  bool {{ cppClassName }}::HasInstance(Handle<v8::Value> value) {
+    return value->IsObject() && NanNew(function_template)->HasInstance(value);
   }
 
   {{ cType }} *{{ cppClassName }}::GetValue() {
@@ -117,9 +162,29 @@ using namespace node;
   }
 
   void {{ cppClassName }}::ClearValue() {
+    Footprint::Charge(footprintType, -this->footprint);
+    this->footprint = 0;
     this->raw = NULL;
   }
 
+  // Called once, when the wrapper's scope is disposed of.
+  void {{ cppClassName }}::DisposeInScope(ObjectWrap *wrapper) {
+    {{ cppClassName }} *object = static_cast<{{ cppClassName }} *>(wrapper);
+
+    {% if freeFunctionName %}
+    if ((object->owned || object->selfFreeing) && object->raw != NULL) {
+      {{ freeFunctionName }}(object->raw);
+    }
+    {% else %}
+    if (object->selfFreeing && object->raw != NULL) {
+      free(object->raw);
+    }
+    {% endif %}
+
+    object->ClearValue();
+    object->scope = NULL;
+  }
+
 {% else %}
 
   void {{ cppClassName }}::InitializeComponent(Handle<v8::Object> target) {
@@ -140,7 +205,9 @@ using namespace node;
 
 {% each functions as function %}
   {% if not function.ignore %}
-    {% if function.isAsync %}
+    {% if function.isManual %}
+{{= function.implementation =}}
+    {% elsif function.isAsync %}
       {% partial asyncFunction function %}
     {% else %}
       {% partial syncFunction function %}
@@ -150,6 +217,13 @@ using namespace node;
 
 {% partial fields . %}
 
+{% partial toObject . %}
+
 {% if not cTypeIsUndefined %}
   Persistent<Function> {{ cppClassName }}::constructor_template;
 {% endif %}
+
+{% if cType %}
+  Persistent<FunctionTemplate> {{ cppClassName }}::function_template;
+  Footprint::Type *{{ cppClassName }}::footprintType = Footprint::Register("{{ jsClassName }}");
+{% endif %}
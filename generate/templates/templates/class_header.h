@@ -3,6 +3,7 @@
 // generated from class_header.h
 #include <nan.h>
 #include <string>
+#include <vector>
 
 extern "C" {
 #include <git2.h>
@@ -11,6 +12,17 @@ extern "C" {
 {%endeach%}
 }
 
+#include "../include/argument_arena.h"
+#include "../include/callback_batch.h"
+#include "../include/footprint.h"
+#include "../include/object_cache.h"
+#include "../include/object_pool.h"
+#include "../include/oid_view.h"
+#include "../include/pooled_async_worker.h"
+#include "../include/promise_factory.h"
+#include "../include/scope.h"
+#include "../include/stats.h"
+
 {%each dependencies as dependency%}
 #include "{{ dependency }}"
 {%endeach%}
@@ -36,13 +48,27 @@ class {{ cppClassName }} : public ObjectWrap {
     static void InitializeComponent (Handle<v8::Object> target);
 
     {%if cType%}
+    // Whether value is one of these, and so safe to Unwrap as one.
+    static bool HasInstance(Handle<v8::Value> value);
+
     {{ cType }} *GetValue();
     {{ cType }} **GetRefValue();
     void ClearValue();
 
-    static Handle<v8::Value> New(void *raw, bool selfFreeing);
+    // `owned` objects were handed over by libgit2 and are freed with their
+    // scope, if they have one.
+    static Handle<v8::Value> New(void *raw, bool selfFreeing, bool owned = false);
+    {%endif%}
+    {%if hasToObject%}
+    static Handle<v8::Value> ToObject({{ cType }} *raw);
     {%endif%}
     bool selfFreeing;
+    {%if cType%}
+    static Persistent<FunctionTemplate> function_template;
+    bool owned;
+    Scope *scope;
+    uint64_t scopeEntry;
+    {%endif%}
 
     {% each functions as function %}
       {% if not function.ignore %}
@@ -57,16 +83,20 @@ class {{ cppClassName }} : public ObjectWrap {
             {% endeach %}
     );
 
-    static void {{ function.cppFunctionName }}_{{ arg.name }}_async(uv_async_t* req, int status);
-    static void {{ function.cppFunctionName }}_{{ arg.name }}_asyncPromisePolling(uv_async_t* req, int status);
+    static void {{ function.cppFunctionName }}_{{ arg.name }}_async(void *data);
+    static NAN_METHOD({{ function.cppFunctionName }}_{{ arg.name }}_promiseFulfilled);
+    static NAN_METHOD({{ function.cppFunctionName }}_{{ arg.name }}_promiseRejected);
+            {% if arg.batch %}
+    static void {{ function.cppFunctionName }}_{{ arg.name }}_asyncBatch(void *data);
+    static void {{ function.cppFunctionName }}_{{ arg.name }}_releaseBatchEntry(void *data);
+            {% endif %}
     struct {{ function.cppFunctionName }}_{{ arg.name|titleCase }}Baton {
       {% each arg.args|argsInfo as cbArg %}
       {{ cbArg.cType }} {{ cbArg.name }};
       {% endeach %}
 
-      uv_async_t req;
+      uv_sem_t semaphore;
       {{ arg.return.type }} result;
-      Persistent<Object> promise;
       bool done;
     };
           {% endif %}
@@ -79,7 +109,9 @@ class {{ cppClassName }} : public ObjectWrap {
 
 
     {%if cType%}
-    {{ cppClassName }}({{ cType }} *raw, bool selfFreeing);
+    {{ cppClassName }}({{ cType }} *raw, bool selfFreeing, bool owned);
+
+    static void DisposeInScope(ObjectWrap *wrapper);
     ~{{ cppClassName }}();
     {%endif%}
 
@@ -101,6 +133,15 @@ class {{ cppClassName }} : public ObjectWrap {
       {%endif%}
     {%endeach%}
 
+    {%if hasToObject%}
+    static NAN_METHOD(JSToObject);
+      {%each fields as field%}
+        {%if not field.ignore%}
+    static Persistent<String> {{ field.cppFunctionName }}Key;
+        {%endif%}
+      {%endeach%}
+    {%endif%}
+
     {%each functions as function%}
       {%if not function.ignore%}
         {%if function.isAsync%}
@@ -108,31 +149,23 @@ class {{ cppClassName }} : public ObjectWrap {
     struct {{ function.cppFunctionName }}Baton {
       int error_code;
       const git_error* error;
+      ArgumentArena arena;
       {%each function.args as arg%}
         {%if arg.isReturn%}
       {{ arg.cType|replace "**" "*" }} {{ arg.name }};
         {%else%}
       {{ arg.cType }} {{ arg.name }};
-          {%if arg | isOid %}
-      bool {{ arg.name }}NeedsFree;
-          {%endif%}
         {%endif%}
       {%endeach%}
     };
-    class {{ function.cppFunctionName }}Worker : public NanAsyncWorker {
+    class {{ function.cppFunctionName }}Worker : public PooledAsyncWorker<{{ function.cppFunctionName }}Worker> {
       public:
-        {{ function.cppFunctionName }}Worker(
-            {{ function.cppFunctionName }}Baton *_baton,
-            NanCallback *callback
-        ) : NanAsyncWorker(callback)
-          , baton(_baton) {};
-        ~{{ function.cppFunctionName }}Worker() {};
         void Execute();
         void HandleOKCallback();
 
-      private:
         {{ function.cppFunctionName }}Baton *baton;
     };
+    static NAN_METHOD({{ function.cppFunctionName }}Start);
         {%endif%}
 
     static NAN_METHOD({{ function.cppFunctionName }});
@@ -147,6 +180,9 @@ class {{ cppClassName }} : public ObjectWrap {
           {%each function.args as arg %}
             {%if arg.isCallbackFunction %}
       NanCallback * {{ arg.name }};
+              {%if arg.batch %}
+      CallbackBatch * {{ arg.name }}Batch;
+              {%endif%}
             {%endif%}
           {%endeach%}
 
@@ -154,6 +190,9 @@ class {{ cppClassName }} : public ObjectWrap {
           {%each function.args as arg %}
             {%if arg.isCallbackFunction %}
         {{ arg.name }} = NULL;
+              {%if arg.batch %}
+        {{ arg.name }}Batch = NULL;
+              {%endif%}
             {%endif%}
           {%endeach%}
       }
@@ -161,6 +200,11 @@ class {{ cppClassName }} : public ObjectWrap {
       ~{{ function.cppFunctionName }}_globalPayload() {
           {%each function.args as arg %}
             {%if arg.isCallbackFunction %}
+              {%if arg.batch %}
+        if ({{ arg.name }}Batch != NULL) {
+          {{ arg.name }}Batch->Dispose();
+        }
+              {%endif%}
         if ({{ arg.name }} != NULL) {
           delete {{ arg.name }};
         }
@@ -174,6 +218,9 @@ class {{ cppClassName }} : public ObjectWrap {
 
     {%if cType%}
     {{ cType }} *raw;
+
+    static Footprint::Type *footprintType;
+    int64_t footprint;
     {%endif%}
 };
 
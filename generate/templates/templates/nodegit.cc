@@ -4,6 +4,18 @@
 #include <git2.h>
 
 #include "../include/wrapper.h"
+#include "../include/callback_batch.h"
+#include "../include/callback_dispatcher.h"
+#include "../include/cancel_token.h"
+#include "../include/commit_graph.h"
+#include "../include/footprint.h"
+#include "../include/promise_factory.h"
+#include "../include/revwalk_filter.h"
+#include "../include/scope.h"
+#include "../include/stats.h"
+#include "../include/thread_pool.h"
+#include "../include/trace_buffer.h"
+#include "../include/tree_walk.h"
 #include "../include/functions/copy.h"
 {% each %}
   {% if type != "enum" %}
@@ -14,6 +26,18 @@
 extern "C" void init(Handle<v8::Object> target) {
   NanScope();
 
+  CallbackBatch::Initialize();
+  CallbackDispatcher::Initialize();
+  CommitGraph::Initialize();
+  TraceBuffer::Initialize();
+  ThreadPool::InitializeComponent(target);
+  CancelToken::InitializeComponent(target);
+  Footprint::InitializeComponent(target);
+  PromiseFactory::InitializeComponent(target);
+  RevwalkFilter::InitializeComponent(target);
+  Scope::InitializeComponent(target);
+  Stats::InitializeComponent(target);
+  TreeWalk::InitializeComponent(target);
   Wrapper::InitializeComponent(target);
   {% each %}
     {% if type != "enum" %}
@@ -16,40 +16,9 @@ catch (ex) {
   rawApi = require("../build/Debug/nodegit");
 }
 
-// Native methods do not return an identifiable function, so we
-// have to override them here
-/* jshint ignore:start */
-{% each . as idef %}
-  {% if idef.type != "enum" %}
-
-    var _{{ idef.jsClassName }}
-      = rawApi.{{idef.jsClassName}};
-
-    {% each idef.functions as fn %}
-      {% if fn.isAsync %}
-
-        {% if fn.isPrototypeMethod %}
-
-          var _{{ idef.jsClassName }}_{{ fn.jsFunctionName}}
-            = _{{ idef.jsClassName }}.prototype.{{ fn.jsFunctionName }};
-          _{{ idef.jsClassName }}.prototype.{{ fn.jsFunctionName }}
-            = promisify(_{{ idef.jsClassName }}_{{ fn.jsFunctionName}});
-
-        {% else %}
-
-          var _{{ idef.jsClassName }}_{{ fn.jsFunctionName}}
-            = _{{ idef.jsClassName }}.{{ fn.jsFunctionName }};
-          _{{ idef.jsClassName }}.{{ fn.jsFunctionName }}
-            = promisify(_{{ idef.jsClassName }}_{{ fn.jsFunctionName}});
-
-        {% endif %}
-
-      {% endif %}
-    {% endeach %}
-
-  {% endif %}
-{% endeach %}
-/* jshint ignore:end */
+// Async methods called without a callback return one of these promises,
+// created and settled natively.
+rawApi.setPromiseConstructor(Promise);
 
 // Set the exports prototype to the raw API.
 exports.__proto__ = rawApi;
@@ -67,6 +36,8 @@ var importExtension = function(name) {
 
 // Load up utils
 rawApi.Utils = {};
+require("./utils/batched");
+require("./utils/chunk_stream");
 require("./utils/lookup_wrapper");
 require("./utils/normalize_options");
 
@@ -89,6 +60,8 @@ require("./enums.js");
     {% each idef.functions as fn %}
       {% if fn.useAsOnRootProto %}
 
+        var _{{ idef.jsClassName }} = rawApi.{{ idef.jsClassName }};
+
         // Inherit directly from the original {{idef.jsClassName}} object.
         _{{ idef.jsClassName }}.{{ fn.jsFunctionName }}.__proto__ =
           _{{ idef.jsClassName }};
@@ -1,8 +1,6 @@
 // This is a generated file, modify: generate/templates/struct_content.cc.
 #include <nan.h>
 #include <string.h>
-#include <chrono>
-#include <thread>
 
 extern "C" {
   #include <git2.h>
@@ -13,6 +11,9 @@ extern "C" {
 
 #include <iostream>
 #include "../include/functions/copy.h"
+#include "../include/callback_dispatcher.h"
+#include "../include/cancel_token.h"
+#include "../include/thread_pool.h"
 #include "../include/{{ filename }}.h"
 
 {% each dependencies as dependency %}
@@ -36,19 +37,35 @@ using namespace std;
 
   this->ConstructFields();
   this->selfFreeing = true;
+
+  Footprint::Created(footprintType);
+  this->footprint = sizeof({{ cType }});
+  Footprint::Charge(footprintType, this->footprint);
 }
 
 {{ cppClassName }}::{{ cppClassName }}({{ cType }}* raw, bool selfFreeing) {
   this->raw = raw;
   this->ConstructFields();
   this->selfFreeing = selfFreeing;
+
+  Footprint::Created(footprintType);
+  this->footprint = selfFreeing ? sizeof({{ cType }}) : 0;
+  Footprint::Charge(footprintType, this->footprint);
 }
 
 {{ cppClassName }}::~{{ cppClassName }}() {
+  Footprint::Charge(footprintType, -this->footprint);
+  Footprint::Destroyed(footprintType);
+
   {% each fields|fieldsInfo as field %}
     {% if not field.ignore %}
       {% if not field.isEnum %}
         {% if field.isCallbackFunction %}
+          {% if field.batch %}
+  if (this->{{ field.name }}Batch != NULL) {
+    this->{{ field.name }}Batch->Dispose();
+  }
+          {% endif %}
   if (this->{{ field.name }} != NULL) {
     delete this->{{ field.name }};
     this->raw->{{ fields|payloadFor field.name }} = NULL;
@@ -81,6 +98,9 @@ void {{ cppClassName }}::ConstructFields() {
           this->raw->{{ field.name }} = NULL;
           this->raw->{{ fields|payloadFor field.name }} = (void *)this;
           this->{{ field.name }} = NULL;
+          {% if field.batch %}
+          this->{{ field.name }}Batch = NULL;
+          {% endif %}
         {% elsif field.payloadFor %}
 
           Local<Value> {{ field.name }} = NanUndefined();
@@ -144,9 +164,12 @@ Handle<v8::Value> {{ cppClassName }}::New(void* raw, bool selfFreeing) {
 }
 
 void {{ cppClassName }}::ClearValue() {
+  Footprint::Charge(footprintType, -this->footprint);
+  this->footprint = 0;
   this->raw = NULL;
 }
 
 {% partial fieldAccessors . %}
 
 Persistent<Function> {{ cppClassName }}::constructor_template;
+Footprint::Type *{{ cppClassName }}::footprintType = Footprint::Register("{{ jsClassName }}");
@@ -3,6 +3,7 @@
 // generated from struct_header.h
 #include <nan.h>
 #include <string>
+#include <vector>
 
 extern "C" {
   #include <git2.h>
@@ -11,6 +12,10 @@ extern "C" {
   {% endeach %}
 }
 
+#include "../include/callback_batch.h"
+#include "../include/footprint.h"
+#include "../include/promise_factory.h"
+
 {% each dependencies as dependency %}
   #include "{{ dependency }}"
 {% endeach %}
@@ -44,16 +49,20 @@ class {{ cppClassName }} : public ObjectWrap {
             {% endeach %}
           );
 
-          static void {{ field.name }}_async(uv_async_t* req, int status);
-          static void {{ field.name }}_asyncPromisePolling(uv_async_t* req, int status);
+          static void {{ field.name }}_async(void *data);
+          static NAN_METHOD({{ field.name }}_promiseFulfilled);
+          static NAN_METHOD({{ field.name }}_promiseRejected);
+          {% if field.batch %}
+          static void {{ field.name }}_asyncBatch(void *data);
+          static void {{ field.name }}_releaseBatchEntry(void *data);
+          {% endif %}
           struct {{ field.name|titleCase }}Baton {
             {% each field.args|argsInfo as arg %}
               {{ arg.cType }} {{ arg.name}};
             {% endeach %}
 
-            uv_async_t req;
+            uv_sem_t semaphore;
             {{ field.return.type }} result;
-            Persistent<Object> promise;
             bool done;
           };
         {% endif %}
@@ -75,6 +84,9 @@ class {{ cppClassName }} : public ObjectWrap {
             Persistent<Object> {{ field.name }};
           {% elsif field.isCallbackFunction %}
             NanCallback* {{ field.name }};
+            {% if field.batch %}
+            CallbackBatch* {{ field.name }}Batch;
+            {% endif %}
           {% elsif field.payloadFor %}
             Persistent<Value> {{ field.name }};
           {% endif %}
@@ -87,6 +99,9 @@ class {{ cppClassName }} : public ObjectWrap {
     {% endeach %}
 
     {{ cType }} *raw;
+
+    static Footprint::Type *footprintType;
+    int64_t footprint;
 };
 
 #endif
@@ -1,6 +1,7 @@
 var NodeGit = require("../");
 var Blob = NodeGit.Blob;
 var LookupWrapper = NodeGit.Utils.lookupWrapper;
+var LookupSyncWrapper = NodeGit.Utils.lookupSyncWrapper;
 var TreeEntry = NodeGit.TreeEntry;
 
 
@@ -14,13 +15,12 @@ var TreeEntry = NodeGit.TreeEntry;
 Blob.lookup = LookupWrapper(Blob);
 
 /**
- * Retrieve the content of the Blob.
- *
- * @return {Buffer} Contents as a buffer.
- */
-Blob.prototype.content = function() {
-  return this.rawcontent().toBuffer(this.rawsize());
-};
+* Retrieves the blob pointed to by the oid on the calling thread
+* @param {Repository} repo The repo that the blob lives in
+* @param {String|Oid|Blob} id The blob to lookup
+* @return {Blob}
+*/
+Blob.lookupSync = LookupSyncWrapper(Blob);
 
 /**
  * Retrieve the Blob's content as String.
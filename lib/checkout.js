@@ -11,12 +11,13 @@ var tree = Checkout.tree;
 * @async
 * @param {Repository} repo The repo to checkout head
 * @param {CheckoutOptions} [options] Options for the checkout
+* @param {CancelToken} [cancelToken]
 * @return {Void} checkout complete
 */
-Checkout.head = function(url, options) {
+Checkout.head = function(url, options, cancelToken) {
   options = normalizeOptions(options, NodeGit.CheckoutOptions);
 
-  return head.call(this, url, options);
+  return head.call(this, url, options, cancelToken);
 };
 
 /**
@@ -26,10 +27,11 @@ Checkout.head = function(url, options) {
 * @param {Repository} repo
 * @param {Oid|Tree|Commit|Reference} treeish
 * @param {CheckoutOptions} [options]
+* @param {CancelToken} [cancelToken]
 * @return {Void} checkout complete
 */
-Checkout.tree = function(repo, treeish, options) {
+Checkout.tree = function(repo, treeish, options, cancelToken) {
   options = normalizeOptions(options, NodeGit.CheckoutOptions);
 
-  return tree.call(this, repo, treeish, options);
+  return tree.call(this, repo, treeish, options, cancelToken);
 };
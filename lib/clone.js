@@ -12,9 +12,10 @@ var clone = Clone.clone;
  * @param {String} url url of the repository
  * @param {String} local_path local path to store repository
  * @param {CloneOptions} [options]
+ * @param {CancelToken} [cancelToken] stops the clone once cancelled
  * @return {Repository} repo
  */
-Clone.clone = function(url, local_path, options) {
+Clone.clone = function(url, local_path, options, cancelToken) {
   var remoteCallbacks;
 
   if (options) {
@@ -42,7 +43,7 @@ Clone.clone = function(url, local_path, options) {
     return NodeGit.Repository.open(local_path);
   };
 
-  return clone.call(this, url, local_path, options)
+  return clone.call(this, url, local_path, options, cancelToken)
     .then(freeRepository)
     .then(openRepository);
 };
@@ -3,6 +3,7 @@ var Promise = require("nodegit-promise");
 var NodeGit = require("../");
 var Commit = NodeGit.Commit;
 var LookupWrapper = NodeGit.Utils.lookupWrapper;
+var LookupSyncWrapper = NodeGit.Utils.lookupSyncWrapper;
 
 /**
  * Retrieves the commit pointed to by the oid
@@ -13,6 +14,14 @@ var LookupWrapper = NodeGit.Utils.lookupWrapper;
  */
 Commit.lookup = LookupWrapper(Commit);
 
+/**
+ * Retrieves the commit pointed to by the oid on the calling thread
+ * @param {Repository} repo The repo that the commit lives in
+ * @param {String|Oid|Commit} id The commit to lookup
+ * @return {Commit}
+ */
+Commit.lookupSync = LookupSyncWrapper(Commit);
+
 /**
  * Retrieve the SHA.
  * @return {String}
@@ -110,6 +119,46 @@ Commit.prototype.history = function() {
   return event;
 };
 
+/**
+ * Stream the history from this commit backwards as chunks of commit
+ * metadata, read natively instead of through a Commit per entry. See
+ * `Revwalk.prototype.historyStream` for what a chunk holds.
+ *
+ * @param {Object} options
+ * @param {Array<Number>} options.sorting Revwalk.SORT flags
+ * @param {Array<Oid|String>} options.hide Commits to leave out, along
+ *                                         with their ancestors
+ * @param {Object} options.filter Only the commits that pass it, see
+ *                                `Revwalk.prototype.setFilter`
+ * @param {String} options.path Only the commits that change this path, as
+ *                              `git log --full-history -- <path>` lists
+ *                              them, see
+ *                              `Revwalk.prototype.pathHistoryStream`
+ * @param {Boolean} options.followRenames Follow path across renames
+ * @param {Number} options.chunkSize Most commits per chunk
+ * @return {stream.Readable}
+ */
+Commit.prototype.historyStream = function(options) {
+  var revwalk = this.repo.createRevWalk();
+
+  options = options || {};
+
+  revwalk.sorting.apply(revwalk, options.sorting || []);
+  if (options.filter) {
+    revwalk.setFilter(options.filter);
+  }
+  revwalk.push(this.id());
+  (options.hide || []).forEach(function(id) {
+    revwalk.hide(typeof id === "string" ? NodeGit.Oid.fromString(id) : id);
+  });
+
+  if (options.path) {
+    return revwalk.pathHistoryStream(options.path, options);
+  }
+
+  return revwalk.historyStream(options.chunkSize);
+};
+
 
 /**
  * Retrieve the commit's parents as commit objects.
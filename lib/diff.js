@@ -23,37 +23,37 @@ Diff.prototype.patches = function() {
 
 // Override Diff.indexToWorkdir to normalize opts
 var indexToWorkdir = Diff.indexToWorkdir;
-Diff.indexToWorkdir = function(repo, index, opts) {
+Diff.indexToWorkdir = function(repo, index, opts, cancelToken) {
   opts = normalizeOptions(opts, NodeGit.DiffOptions);
-  return indexToWorkdir(repo, index, opts);
+  return indexToWorkdir(repo, index, opts, cancelToken);
 };
 
 // Override Diff.treeToIndex to normalize opts
 var treeToIndex = Diff.treeToIndex;
-Diff.treeToIndex = function(repo, tree, index, opts) {
+Diff.treeToIndex = function(repo, tree, index, opts, cancelToken) {
   opts = normalizeOptions(opts, NodeGit.DiffOptions);
-  return treeToIndex(repo, tree, index, opts);
+  return treeToIndex(repo, tree, index, opts, cancelToken);
 };
 
 // Override Diff.treeToTree to normalize opts
 var treeToTree = Diff.treeToTree;
-Diff.treeToTree = function(repo, from_tree, to_tree, opts) {
+Diff.treeToTree = function(repo, from_tree, to_tree, opts, cancelToken) {
   opts = normalizeOptions(opts, NodeGit.DiffOptions);
-  return treeToTree(repo, from_tree, to_tree, opts);
+  return treeToTree(repo, from_tree, to_tree, opts, cancelToken);
 };
 
 // Override Diff.treeToWorkdir to normalize opts
 var treeToWorkdir = Diff.treeToWorkdir;
-Diff.treeToWorkdir = function(repo, tree, opts) {
+Diff.treeToWorkdir = function(repo, tree, opts, cancelToken) {
   opts = normalizeOptions(opts, NodeGit.DiffOptions);
-  return treeToWorkdir(repo, tree, opts);
+  return treeToWorkdir(repo, tree, opts, cancelToken);
 };
 
 // Override Diff.treeToWorkdir to normalize opts
 var treeToWorkdirWithIndex = Diff.treeToWorkdirWithIndex;
-Diff.treeToWorkdirWithIndex = function(repo, tree, opts) {
+Diff.treeToWorkdirWithIndex = function(repo, tree, opts, cancelToken) {
   opts = normalizeOptions(opts, NodeGit.DiffOptions);
-  return treeToWorkdirWithIndex(repo, tree, opts);
+  return treeToWorkdirWithIndex(repo, tree, opts, cancelToken);
 };
 
 // Override Diff.findSimilar to normalize opts
@@ -0,0 +1,68 @@
+var NodeGit = require("../");
+var Promise = require("nodegit-promise");
+
+var Graph = NodeGit.Graph;
+var Oid = NodeGit.Oid;
+var aheadBehindMany = Graph.aheadBehindMany;
+
+// Tips per native call. The calls only read, so the thread pool runs them
+// side by side.
+var TIPS_PER_CALL = 256;
+
+/**
+ * Counts how far each tip is ahead of and behind one base, like calling
+ * Graph.aheadBehind(repo, tip, base) for every tip but without a trip
+ * through the thread pool for each. With a commit graph (see
+ * Graph.writeCommitGraph) no commit is parsed at all.
+ *
+ * @async
+ * @param {Repository} repo
+ * @param {Oid|String|Commit} base
+ * @param {Array<Oid|String|Commit>|Buffer} tips Packed oids or a list
+ * @param {Object} options
+ * @param {Boolean} options.mergeBases Also find each tip's merge base with
+ *                                     base, null where there is none
+ * @return {Array<Object>} `{ahead, behind, mergeBase}` for every tip
+ */
+Graph.aheadBehindMany = function(repo, base, tips, options, callback) {
+  if (typeof options === "function") {
+    callback = options;
+    options = null;
+  }
+
+  var mergeBases = !!(options && options.mergeBases);
+  var packedBase = Oid.pack([base]);
+  var packedTips = Oid.pack(tips);
+  var calls = [];
+
+  for (var start = 0; start < packedTips.length;
+      start += TIPS_PER_CALL * 20) {
+    calls.push(aheadBehindMany.call(this, repo, packedBase,
+      packedTips.slice(start, start + TIPS_PER_CALL * 20), mergeBases));
+  }
+
+  return Promise.all(calls).then(function(chunks) {
+    var results = [];
+
+    chunks.forEach(function(chunk) {
+      var bases = chunk.mergeBases && Oid.toStrings(chunk.mergeBases);
+
+      chunk.ahead.forEach(function(ahead, index) {
+        var result = { ahead: ahead, behind: chunk.behind[index] };
+
+        if (bases) {
+          result.mergeBase = /^0+$/.test(bases[index]) ?
+            null : Oid.fromString(bases[index]);
+        }
+
+        results.push(result);
+      });
+    });
+
+    if (typeof callback === "function") {
+      callback(null, results);
+    }
+
+    return results;
+  }, callback);
+};
@@ -3,7 +3,10 @@ var normalizeOptions = NodeGit.Utils.normalizeOptions;
 var Promise = require("nodegit-promise");
 
 var Merge = NodeGit.Merge;
+var Oid = NodeGit.Oid;
 var mergeCommits = Merge.commits;
+var mergeBaseMany = Merge.baseMany;
+var mergeBaseOctopus = Merge.baseOctopus;
 
 /**
  * Merge 2 commits together and create an new index that can
@@ -24,3 +27,46 @@ Merge.commits = function(repo, ourCommit, theirCommit, options) {
     return mergeCommits.call(this, repo, commits[0], commits[1], options);
   });
 };
+
+/**
+ * Find a merge base for merging the first commit with all of the others at
+ * once, like `git merge-base` given them all.
+ *
+ * @async
+ * @param {Repository} repo Repository that contains the given commits
+ * @param {Array<Oid|String|Commit>|Buffer} ids Packed oids or a list
+ * @return {Oid}
+ */
+Merge.baseMany = function(repo, ids, callback) {
+  return mergeBaseMany.call(this, repo, Oid.pack(ids)).then(function(base) {
+    var oid = Oid.fromString(base.toString("hex"));
+
+    if (typeof callback === "function") {
+      callback(null, oid);
+    }
+
+    return oid;
+  }, callback);
+};
+
+/**
+ * Find a merge base for an octopus merge of all of the commits, like
+ * `git merge-base --octopus`.
+ *
+ * @async
+ * @param {Repository} repo Repository that contains the given commits
+ * @param {Array<Oid|String|Commit>|Buffer} ids Packed oids or a list
+ * @return {Oid}
+ */
+Merge.baseOctopus = function(repo, ids, callback) {
+  return mergeBaseOctopus.call(this, repo, Oid.pack(ids))
+    .then(function(base) {
+      var oid = Oid.fromString(base.toString("hex"));
+
+      if (typeof callback === "function") {
+        callback(null, oid);
+      }
+
+      return oid;
+    }, callback);
+};
@@ -12,5 +12,16 @@ Note.foreach = function(repo, notesRef, callback) {
     return callback(blobId.copy(), objectId.copy());
   }
 
+  function batchedWrapperCallback(entries) {
+    return callback(entries.map(function(entry) {
+      return [entry[0].copy(), entry[1].copy()];
+    }));
+  }
+
+  if (callback.batch) {
+    batchedWrapperCallback.batch = callback.batch;
+    return foreach(repo, notesRef, batchedWrapperCallback, null);
+  }
+
   return foreach(repo, notesRef, wrapperCallback, null);
 };
@@ -5,5 +5,5 @@ var OdbObject = NodeGit.OdbObject;
 OdbObject.prototype.toString = function(size) {
   size = size || this.size();
 
-  return this.data().toBuffer(size).toString();
+  return this.data().toString("utf8", 0, size);
 };
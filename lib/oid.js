@@ -21,3 +21,45 @@ Oid.prototype.copy = function() {
 Oid.prototype.inspect = function() {
   return "[Oid " + this.allocfmt() + "]";
 };
+
+/**
+ * Returns the oid at index in a Buffer of packed oids, like the one returned
+ * by Oid.fromStrings. The result shares memory with ids and can be passed
+ * anywhere an Oid is accepted.
+ *
+ * @param {Buffer|Uint8Array} ids
+ * @param {Number} index
+ * @return {Buffer|Uint8Array}
+ */
+Oid.at = function(ids, index) {
+  var start = index * 20;
+
+  // Buffer#slice shares memory, Uint8Array#slice copies.
+  if (Buffer.isBuffer(ids)) {
+    return ids.slice(start, start + 20);
+  }
+
+  return ids.subarray(start, start + 20);
+};
+
+/**
+ * Packs oids given as Oid, String, Commit or 20 byte Buffer into a single
+ * Buffer, 20 bytes each, for the calls that take packed oids. A Buffer is
+ * assumed to be packed already and is returned as it is.
+ *
+ * @param {Array<Oid|String|Commit|Buffer>|Buffer} ids
+ * @return {Buffer}
+ */
+Oid.pack = function(ids) {
+  if (Buffer.isBuffer(ids)) {
+    return ids;
+  }
+
+  return Oid.fromStrings(ids.map(function(id) {
+    if (Buffer.isBuffer(id)) {
+      return id.toString("hex");
+    }
+
+    return typeof id === "string" ? id : id.toString();
+  }));
+};
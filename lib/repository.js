@@ -8,6 +8,7 @@ var Reference = NodeGit.Reference;
 var Remote = NodeGit.Remote;
 var Repository = NodeGit.Repository;
 var Revwalk = NodeGit.Revwalk;
+var Scope = NodeGit.Scope;
 var Status = NodeGit.Status;
 var StatusFile = NodeGit.StatusFile;
 var StatusList = NodeGit.StatusList;
@@ -843,6 +844,44 @@ Repository.prototype.checkoutBranch = function(branch, opts) {
   });
 };
 
+/**
+ * Runs `fn` with a handle on this repository whose objects are all freed
+ * as soon as the promise `fn` returns settles, instead of whenever the
+ * garbage collector gets to them. Anything looked up through the scoped
+ * repository, or through what it returns, throws if it is used after that.
+ *
+ * The scoped repository is a second one, opened from this repository's
+ * path, so that it can be freed with everything else in the scope while
+ * this one stays open. It sees the same data on disk, and objects from this
+ * repository can be passed to it; they are left alone when the scope ends.
+ * Its caches are its own, though, so nothing looked up through this
+ * repository is reused in the scope, and objects from the two shouldn't be
+ * mixed where libgit2 expects them to share an owner.
+ *
+ * @async
+ * @param {Function} fn Called with the scoped Repository and its Scope,
+ *                      returns a value or a promise for one
+ * @return {*} What fn resolves to
+ */
+Repository.prototype.scope = function(fn) {
+  var path = this.path();
+  var scope = new Scope();
+
+  return scope.run(function() {
+      return Repository.open(path);
+    })
+    .then(function(repository) {
+      return fn(repository, scope);
+    })
+    .then(function(result) {
+      scope.dispose();
+      return result;
+    }, function(error) {
+      scope.dispose();
+      throw error;
+    });
+};
+
 var fetchheadForeach = Repository.prototype.fetchheadForeach;
 /**
  * @async
@@ -1,5 +1,7 @@
 var NodeGit = require("../");
+var Oid = NodeGit.Oid;
 var Revwalk = NodeGit.Revwalk;
+var chunkStream = NodeGit.Utils.chunkStream;
 var Promise = require("nodegit-promise");
 
 var oldSorting = Revwalk.prototype.sorting;
@@ -20,68 +22,119 @@ Revwalk.prototype.sorting = function() {
   oldSorting.call(this, sort);
 };
 
+// Oids come off the walk in batches that start small, so stopping early
+// doesn't look up much that goes unused, and double up to the largest.
+var FIRST_BATCH = 32;
+var LARGEST_BATCH = 1024;
+
 /**
- * Walk the history from the given oid. The callback is invoked for each commit;
- * When the walk is over, the callback is invoked with `(null, null)`.
+ * Looks up the commit for every oid in a packed Buffer, in order.
  *
- * @param  {Oid} oid
- * @param  {Function} callback
- * @return {Commit}
+ * @param {Repository} repo
+ * @param {Buffer} ids
+ * @return {Array<Commit>}
  */
-Revwalk.prototype.walk = function(oid, callback) {
-  var revwalk = this;
+function getBatchCommits(repo, ids) {
+  var commits = [];
 
-  this.push(oid);
+  for (var i = 0; i < ids.length / 20; i++) {
+    commits.push(repo.getCommit(Oid.at(ids, i)));
+  }
 
-  function walk() {
-    revwalk.next().then(function(oid) {
-      if (!oid) {
-        if (typeof callback === "function") {
-          return callback();
-        }
+  return Promise.all(commits);
+}
+
+/**
+ * Calls onCommit with each commit, in order, until it returns false or the
+ * walk is over.
+ *
+ * Oids are taken off the walk a whole batch at a time, so when onCommit
+ * stops early, the rest of its batch has already been taken off the walk
+ * and is dropped.
+ *
+ * @param {Revwalk} walker
+ * @param {Number} limit Most commits to visit, or Infinity
+ * @param {Function} onCommit
+ * @return {Promise}
+ */
+function eachCommit(walker, limit, onCommit) {
+  var batch = FIRST_BATCH;
+  var visited = 0;
+
+  function nextBatch() {
+    var count = Math.min(batch, limit - visited);
 
-        return;
-      }
+    if (count <= 0) {
+      return Promise.resolve();
+    }
 
-      revwalk.repo.getCommit(oid).then(function(commit) {
-        if (typeof callback === "function") {
-          callback(null, commit);
+    batch = Math.min(batch * 2, LARGEST_BATCH);
+
+    return walker.nextBatch(count)
+      .then(function(ids) {
+        return getBatchCommits(walker.repo, ids);
+      })
+      .then(function(commits) {
+        for (var i = 0; i < commits.length; i++) {
+          visited++;
+
+          if (onCommit(commits[i]) === false) {
+            return;
+          }
         }
 
-        walk();
+        if (commits.length === count) {
+          return nextBatch();
+        }
       });
-    }, callback);
   }
 
-  walk();
-};
+  return nextBatch();
+}
 
+/**
+ * Walk the history from the given oid. The callback is invoked for each commit;
+ * When the walk is over, the callback is invoked with `(null, null)`.
+ *
+ * @param  {Oid} oid
+ * @param  {Function} callback
+ * @return {Commit}
+ */
+Revwalk.prototype.walk = function(oid, callback) {
+  this.push(oid);
+
+  eachCommit(this, Infinity, function(commit) {
+    if (typeof callback === "function") {
+      callback(null, commit);
+    }
+  })
+  .then(function() {
+    if (typeof callback === "function") {
+      callback();
+    }
+  }, callback);
+};
 
 /**
  * Walk the history grabbing commits until the checkFn called with the
  * current commit returns false.
  *
+ * The walk is read ahead in batches, so by the time this resolves up to
+ * 1024 more commits may have been taken off it. Don't keep using the walker
+ * afterwards expecting to carry on from the commit checkFn stopped at;
+ * reset it, or use getCommits for an exact count.
+ *
  * @param  {Function} checkFn function returns false to stop walking
  * @return {Array}
  */
 Revwalk.prototype.getCommitsUntil = function(checkFn) {
   var commits = [];
-  var walker = this;
-
-  function walkCommitsCb() {
-    return walker.next().then(function(oid) {
-      if (!oid) { return; }
 
-      return walker.repo.getCommit(oid).then(function(commit) {
-        commits.push(commit);
-        if (checkFn(commit)) {
-          return walkCommitsCb();
-        }
-      });
-    });
-  }
-
-  return walkCommitsCb().then(function() {
+  return eachCommit(this, Infinity, function(commit) {
+    commits.push(commit);
+    return !!checkFn(commit);
+  })
+  .then(function() {
     return commits;
   });
 };
@@ -93,22 +146,123 @@ Revwalk.prototype.getCommitsUntil = function(checkFn) {
  * @return {Array<Commit>}
  */
 Revwalk.prototype.getCommits = function(count) {
-  count = count || 10;
-  var promises = [];
   var walker = this;
 
-  function walkCommitsCount(count) {
-    if (count === 0) { return; }
+  return this.nextBatch(count || 10)
+    .then(function(ids) {
+      return getBatchCommits(walker.repo, ids);
+    });
+};
 
-    return walker.next().then(function(oid) {
-      if (!oid) { return; }
+function toSeconds(time) {
+  return time instanceof Date ? Math.floor(time.getTime() / 1000) : time;
+}
 
-      promises.push(walker.repo.getCommit(oid));
-      return walkCommitsCount(count - 1);
-    });
+/**
+ * Only give back the commits that pass a filter from now on, checked on a
+ * worker so the rest never reach JavaScript. Used by `historyStream`, or
+ * pass `this.filter` to `nextMatching` directly. hide has to be set before
+ * anything is pushed, and only once per walk.
+ *
+ * author and committer are POSIX extended regular expressions, as
+ * `git log -E --author` takes, not JavaScript ones: `\d`, lookaheads and
+ * the like don't exist there, so a RegExp is refused rather than quietly
+ * matched as something else.
+ *
+ * @param  {Object} options
+ * @param  {String} options.author Matched against "Name <email>"
+ * @param  {Boolean} options.authorIgnoreCase
+ * @param  {String} options.committer Matched against "Name <email>"
+ * @param  {Boolean} options.committerIgnoreCase
+ * @param  {Date|Number} options.since Oldest commit time, in seconds
+ * @param  {Date|Number} options.until Newest commit time, in seconds
+ * @param  {Number} options.minParents 2 for merges only
+ * @param  {Number} options.maxParents 1 for no merges
+ * @param  {Array<Oid|String|Commit>|Buffer} options.hide Leave these out,
+ *                                                        with their history
+ * @param  {Array<String>} options.paths Only commits changing one of them
+ * @return {RevwalkFilter}
+ */
+Revwalk.prototype.setFilter = function(options) {
+  if (options.author instanceof RegExp ||
+      options.committer instanceof RegExp) {
+    throw new TypeError("author and committer must be Strings holding " +
+      "POSIX extended regular expressions, not RegExps.");
   }
 
-  return walkCommitsCount(count).then(function() {
-    return Promise.all(promises);
+  this.filter = new NodeGit.RevwalkFilter({
+    author: options.author,
+    authorIgnoreCase: !!options.authorIgnoreCase,
+    committer: options.committer,
+    committerIgnoreCase: !!options.committerIgnoreCase,
+    since: toSeconds(options.since),
+    until: toSeconds(options.until),
+    minParents: options.minParents,
+    maxParents: options.maxParents,
+    hide: options.hide && Oid.pack(options.hide),
+    paths: options.paths
   });
+
+  if (options.hide) {
+    this.addHideCb(this.filter);
+  }
+
+  return this.filter;
+};
+
+/**
+ * A readable object stream of what a log view needs about every commit left
+ * in the walk, read on a worker without making a Commit for any of them.
+ * Each chunk holds up to chunkSize commits as parallel arrays, see
+ * `nextMetadata`, so nothing piles up in memory. Only the commits that
+ * pass the filter are included, if one was set.
+ *
+ * @param  {Number} chunkSize Most commits per chunk (default: 256)
+ * @return {stream.Readable}
+ */
+Revwalk.prototype.historyStream = function(chunkSize) {
+  var walker = this;
+  var filter = this.filter;
+
+  chunkSize = chunkSize || 256;
+
+  return chunkStream(function() {
+    return filter ?
+      walker.nextMatching(filter, chunkSize) :
+      walker.nextMetadata(chunkSize);
+  }, chunkSize);
+};
+
+/**
+ * Like `historyStream`, but only for the commits left in the walk that
+ * change what is at path, as `git log --full-history -- <path>` would list
+ * them: every parent of a merge is walked, not only one that left path as
+ * it was, and a merge is listed when path differs from all of its
+ * parents. Trees are
+ * compared on a worker, without a Diff or a Commit per commit. Chunks also
+ * have `paths`, the path each commit changed, which only differs from path
+ * when renames are followed.
+ *
+ * @param  {String} path
+ * @param  {Object} options
+ * @param  {Boolean} options.followRenames Follow the file to where it came
+ *                                         from, like `git log --follow`
+ * @param  {Number} options.chunkSize Most commits per chunk (default: 64)
+ * @return {stream.Readable}
+ */
+Revwalk.prototype.pathHistoryStream = function(path, options) {
+  var walker = this;
+
+  options = options || {};
+
+  var chunkSize = options.chunkSize || 64;
+  var followRenames = !!options.followRenames;
+
+  return chunkStream(function() {
+    return walker.nextForPath(path, chunkSize, followRenames)
+      .then(function(chunk) {
+        path = chunk.path;
+        return chunk;
+      });
+  }, chunkSize);
 };
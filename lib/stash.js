@@ -12,5 +12,16 @@ Stash.foreach = function(repo, callback) {
     return callback(index, message, oid.copy());
   }
 
+  function batchedWrappedCallback(entries) {
+    return callback(entries.map(function(entry) {
+      return [entry[0], entry[1], entry[2].copy()];
+    }));
+  }
+
+  if (callback.batch) {
+    batchedWrappedCallback.batch = callback.batch;
+    return foreach(repo, batchedWrappedCallback, null);
+  }
+
   return foreach(repo, wrappedCallback, null);
 };
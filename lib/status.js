@@ -5,13 +5,13 @@ var Status = NodeGit.Status;
 
 // Override Status.foreach to eliminate the need to pass null payload
 var foreach = Status.foreach;
-Status.foreach = function(repo, callback) {
-  return foreach(repo, callback, null);
+Status.foreach = function(repo, callback, cancelToken) {
+  return foreach(repo, callback, null, cancelToken);
 };
 
 // Override Status.foreachExt to normalize opts
 var foreachExt = Status.foreachExt;
-Status.foreachExt = function(repo, opts, callback) {
+Status.foreachExt = function(repo, opts, callback, cancelToken) {
   opts = normalizeOptions(opts, NodeGit.StatusOptions);
-  return foreachExt(repo, opts, callback, null);
+  return foreachExt(repo, opts, callback, null, cancelToken);
 };
@@ -1,5 +1,6 @@
 var NodeGit = require("../");
 var LookupWrapper = NodeGit.Utils.lookupWrapper;
+var LookupSyncWrapper = NodeGit.Utils.lookupSyncWrapper;
 var Tag = NodeGit.Tag;
 
 /**
@@ -10,3 +11,11 @@ var Tag = NodeGit.Tag;
 * @return {Tag}
 */
 Tag.lookup = LookupWrapper(Tag);
+
+/**
+* Retrieves the tag pointed to by the oid on the calling thread
+* @param {Repository} repo The repo that the tag lives in
+* @param {String|Oid|Tag} id The tag to lookup
+* @return {Tag}
+*/
+Tag.lookupSync = LookupSyncWrapper(Tag);
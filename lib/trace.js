@@ -0,0 +1,34 @@
+var NodeGit = require("../");
+var Trace = NodeGit.Trace;
+
+/**
+ * Drain the trace buffer every `interval` milliseconds. The callback is
+ * invoked with the messages and the number dropped since the last drain,
+ * whenever there is at least one of either. The timer doesn't keep the
+ * process alive.
+ *
+ * @param {Function} callback
+ * @param {Number} [interval] defaults to 100
+ * @return {Function} stops draining, after one last drain
+ */
+Trace.watch = function(callback, interval) {
+  var drain = function() {
+    var messages = Trace.drain();
+    var dropped = Trace.dropped();
+
+    if (messages.length || dropped) {
+      callback(messages, dropped);
+    }
+  };
+
+  var timer = setInterval(drain, interval || 100);
+
+  if (timer.unref) {
+    timer.unref();
+  }
+
+  return function() {
+    clearInterval(timer);
+    drain();
+  };
+};
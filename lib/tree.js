@@ -2,8 +2,11 @@ var events = require("events");
 var NodeGit = require("../");
 var Diff = NodeGit.Diff;
 var LookupWrapper = NodeGit.Utils.lookupWrapper;
+var LookupSyncWrapper = NodeGit.Utils.lookupSyncWrapper;
 var Tree = NodeGit.Tree;
 var Treebuilder = NodeGit.Treebuilder;
+var TreeWalk = NodeGit.TreeWalk;
+var chunkStream = NodeGit.Utils.chunkStream;
 
 
 /**
@@ -16,6 +19,14 @@ var Treebuilder = NodeGit.Treebuilder;
 */
 Tree.lookup = LookupWrapper(Tree);
 
+/**
+* Retrieves the tree pointed to by the oid on the calling thread
+* @param {Repository} repo The repo that the tree lives in
+* @param {String|Oid|Tree} id The tree to lookup
+* @return {Tree}
+*/
+Tree.lookupSync = LookupSyncWrapper(Tree);
+
 /**
  * Diff two trees
  * @async
@@ -95,7 +106,8 @@ Tree.prototype.entries = function() {
 
 /**
  * Recursively walk the tree in breadth-first order. Fires an event for each
- * entry.
+ * entry. Every subtree is looked up separately and every entry is wrapped,
+ * so for large trees `walkStream` is much cheaper.
  *
  * @fires EventEmitter#entry Tree
  * @fires EventEmitter#end Array<Tree>
@@ -147,6 +159,40 @@ Tree.prototype.walk = function(blobsOnly) {
   return event;
 };
 
+/**
+ * A readable object stream of everything under the tree, depth first, read
+ * on a worker without a TreeEntry or a Tree for any of it. Each chunk holds
+ * up to chunkSize entries as parallel arrays, see `walkNext`, and the next
+ * one is only read once the consumer has caught up.
+ *
+ * @param  {Object} options
+ * @param  {Boolean} options.postOrder Trees after what is in them, instead
+ *                                     of before
+ * @param  {Boolean} options.blobsOnly Only blob & blob executable entries
+ *                                     (default: true)
+ * @param  {Array<String>} options.paths Only what is at or under one of
+ *                                       these; other subtrees aren't read
+ * @param  {Number} options.chunkSize Most entries per chunk (default: 512)
+ * @return {stream.Readable}
+ */
+Tree.prototype.walkStream = function(options) {
+  var tree = this;
+
+  options = options || {};
+
+  var chunkSize = options.chunkSize || 512;
+  var paths = options.paths;
+  var walk = new TreeWalk({
+    postOrder: !!options.postOrder,
+    blobsOnly: options.blobsOnly !== false,
+    paths: typeof paths === "string" ? [paths] : paths
+  });
+
+  return chunkStream(function() {
+    return tree.walkNext(walk, chunkSize);
+  }, chunkSize);
+};
+
 /**
  * Return the path of this tree, like `/lib/foo/bar`
  * @return {String}
@@ -0,0 +1,23 @@
+var NodeGit = require("../../");
+
+/**
+ * Opt a callback into batched delivery. Callbacks marked as batchable in
+ * `generate/input/callbacks.json` will then receive a single array of
+ * argument arrays instead of being invoked once per item.
+ *
+ * Returning a non-zero number from the callback stops the underlying
+ * iteration, just like returning it from a single invocation would.
+ *
+ * @param {Function} callback
+ * @param {Object} [options]
+ * @param {Number} [options.size] maximum number of entries per batch
+ * @param {Number} [options.wait] maximum microseconds an entry is held
+ * @return {Function} the same callback
+ */
+function batched(callback, options) {
+  callback.batch = options || {};
+
+  return callback;
+}
+
+NodeGit.Utils.batched = batched;
@@ -0,0 +1,55 @@
+var Readable = require("stream").Readable;
+var NodeGit = require("../../");
+
+/**
+ * A readable object stream over chunks of columns, like the commits of a
+ * Revwalk or the entries of a TreeWalk. The next chunk is only read once the
+ * consumer has caught up, and a chunk with fewer than chunkSize rows is the
+ * last one.
+ *
+ * @param {Function} readChunk Returns a promise for the next chunk
+ * @param {Number} chunkSize
+ * @return {stream.Readable}
+ */
+function chunkStream(readChunk, chunkSize) {
+  var stream = new Readable({ objectMode: true, highWaterMark: 2 });
+  var reading = false;
+
+  stream._read = function() {
+    if (reading) {
+      return;
+    }
+
+    // Stays set once the stream is over, so nothing is read past the end.
+    reading = true;
+    // Pushing runs "data" listeners, and anything they throw has to escape
+    // instead of being taken for a rejection, so both handlers hand the
+    // result over outside of the promise chain.
+    readChunk().then(function(chunk) {
+      process.nextTick(function() {
+        var last = chunk.count < chunkSize;
+
+        // Cleared first, as push can call _read again straight away.
+        if (!last) {
+          reading = false;
+        }
+
+        if (chunk.count) {
+          stream.push(chunk);
+        }
+
+        if (last) {
+          stream.push(null);
+        }
+      });
+    }, function(error) {
+      process.nextTick(function() {
+        stream.emit("error", error);
+      });
+    });
+  };
+
+  return stream;
+}
+
+NodeGit.Utils.chunkStream = chunkStream;
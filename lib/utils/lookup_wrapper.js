@@ -37,4 +37,24 @@ function lookupWrapper(objectType, lookupFunction) {
   };
 }
 
+/**
+* The blocking counterpart of lookupWrapper, for callers that know the object
+* is hot. The lookup runs on the calling thread, so an object that isn't
+* cached yet is read from disk right there.
+* @param {Object} objectType The object type that you're expecting to receive.
+* @return {Function}
+*/
+function lookupSyncWrapper(objectType) {
+  var lookupFunction = objectType.lookupSync;
+
+  return function(repo, id) {
+    var obj = id instanceof objectType ? id : lookupFunction(repo, id);
+
+    obj.repo = repo;
+
+    return obj;
+  };
+}
+
 NodeGit.Utils.lookupWrapper = lookupWrapper;
+NodeGit.Utils.lookupSyncWrapper = lookupSyncWrapper;
@@ -32,6 +32,16 @@ describe("Blob", function() {
     assert.ok(Buffer.isBuffer(contents));
   });
 
+  it("keeps its content after the blob is freed", function() {
+    var contents = this.blob.content();
+    var size = this.blob.rawsize();
+
+    this.blob.free();
+
+    assert.equal(contents.length, size);
+    assert.equal(contents.toString().slice(0, 7), "@import");
+  });
+
   it("can provide content as a string", function() {
     var contents = this.blob.toString();
 
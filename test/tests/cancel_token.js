@@ -0,0 +1,86 @@
+var assert = require("assert");
+var path = require("path");
+var promisify = require("promisify-node");
+var Promise = require("nodegit-promise");
+var fse = promisify(require("fs-extra"));
+var local = path.join.bind(path, __dirname);
+var exec = promisify(function(command, opts, callback) {
+  return require("child_process").exec(command, opts, callback);
+});
+
+describe("CancelToken", function() {
+  var NodeGit = require("../../");
+  var CancelToken = NodeGit.CancelToken;
+  var Repository = NodeGit.Repository;
+  var Status = NodeGit.Status;
+
+  var reposPath = local("../repos/workdir");
+
+  before(function() {
+    var test = this;
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        test.repository = repository;
+      });
+  });
+
+  it("starts out not cancelled", function() {
+    var token = new CancelToken();
+
+    assert.equal(token.isCancelled(), false);
+    token.cancel();
+    assert.equal(token.isCancelled(), true);
+  });
+
+  it("drops a job that was cancelled before it ran", function() {
+    var token = new CancelToken();
+    var called = false;
+
+    token.cancel();
+
+    return Status.foreach(this.repository, function() {
+      called = true;
+    }, token)
+      .then(function() {
+        assert.fail("the status walk should have been cancelled");
+      }, function(error) {
+        assert.equal(error.message, "The operation was cancelled.");
+        assert.equal(called, false);
+      });
+  });
+
+  it("stops a running job at the next callback", function() {
+    var repo = this.repository;
+    var fileNames = ["cancel-1.file", "cancel-2.file", "cancel-3.file"];
+    var token = new CancelToken();
+    var calls = 0;
+
+    return Promise.all(fileNames.map(function(fileName) {
+      return fse.writeFile(path.join(repo.workdir(), fileName), fileName);
+    }))
+      .then(function() {
+        return Status.foreach(repo, function() {
+          calls++;
+          token.cancel();
+        }, token);
+      })
+      .then(function() {
+        assert.fail("the status walk should have been cancelled");
+      }, function(error) {
+        assert.equal(error.message, "The operation was cancelled.");
+        assert.equal(calls, 1);
+      })
+      .then(function() {
+        return exec("git clean -xdf", {cwd: reposPath});
+      });
+  });
+
+  it("rejects anything else in the token position", function() {
+    return Status.foreach(this.repository, function() {}, {})
+      .then(function() {
+        assert.fail("a plain object is not a cancel token");
+      }, function(error) {
+        assert.equal(error.message, "Cancel token must be a CancelToken.");
+      });
+  });
+});
@@ -34,6 +34,39 @@ describe("Commit", function() {
     });
   });
 
+  it("resolves a cached commit without the thread pool", function() {
+    var ThreadPool = NodeGit.ThreadPool;
+    var completed = ThreadPool.getStats().interactive.completed;
+
+    return NodeGit.Commit.lookup(this.repository, oid)
+      .then(function(commit) {
+        assert.equal(commit.sha(), oid);
+        assert.equal(ThreadPool.getStats().interactive.completed, completed);
+      });
+  });
+
+  it("never calls back for a cached commit before returning", function(done) {
+    var returned = false;
+
+    NodeGit.Commit.lookup(this.repository, oid, function(error, commit) {
+      assert.ok(returned);
+      assert.equal(commit.sha(), oid);
+      done();
+    });
+
+    returned = true;
+  });
+
+  it("can be looked up synchronously", function() {
+    var commit = NodeGit.Commit.lookupSync(this.repository, oid);
+
+    assert.equal(commit.sha(), oid);
+    assert.equal(commit.repo, this.repository);
+    assert.throws(function() {
+      NodeGit.Commit.lookupSync(this.repository, "invalid");
+    }.bind(this));
+  });
+
   it("has a message", function() {
     assert.equal(this.commit.message(), "Update README.md");
   });
@@ -167,6 +200,142 @@ describe("Commit", function() {
     history.start();
   });
 
+  it("can stream its repository's history", function(done) {
+    var commit = this.commit;
+    var historyCount = 0;
+    var first = null;
+
+    var history = commit.historyStream({ chunkSize: 100 });
+
+    history.on("data", function(chunk) {
+      assert(chunk.count <= 100);
+      assert.equal(chunk.ids.length, chunk.count * 20);
+      assert.equal(chunk.summaries.length, chunk.count);
+
+      first = first || chunk;
+      historyCount += chunk.count;
+    });
+
+    history.on("end", function() {
+      assert.equal(historyCount, 364);
+      assert.equal(NodeGit.Oid.toStrings(first.ids)[0], commit.sha());
+      assert.equal(first.authorNames[0], commit.author().name());
+      assert.equal(first.committerTimes[0], commit.time());
+      assert.equal(first.summaries[0], commit.summary());
+
+      done();
+    });
+
+    history.on("error", done);
+  });
+
+  it("can stream the history of a single file", function(done) {
+    var commit = this.commit;
+    var shas = [];
+    var paths = [];
+
+    var history = commit.historyStream({ path: "README.md", chunkSize: 5 });
+
+    history.on("data", function(chunk) {
+      shas = shas.concat(NodeGit.Oid.toStrings(chunk.ids));
+      paths = paths.concat(chunk.paths);
+    });
+
+    history.on("end", function() {
+      // This commit only updated README.md.
+      assert.equal(shas[0], commit.sha());
+      assert(shas.length > 1);
+      assert(shas.length < 364);
+      paths.forEach(function(path) {
+        assert.equal(path, "README.md");
+      });
+
+      done();
+    });
+
+    history.on("error", done);
+  });
+
+  it("can follow a file across a rename", function() {
+    var renamePath = local("../repos/rename");
+    var signature = NodeGit.Signature.create("Foo Bar", "foo@bar.com",
+      123456789, 60);
+    var content = "one\ntwo\nthree\nfour\nfive\n";
+    var repository;
+    var parents = [];
+
+    function commitFiles(message, remove, add, fileContent) {
+      return fse.writeFile(path.join(repository.workdir(), add), fileContent)
+        .then(function() {
+          return remove && fse.remove(path.join(repository.workdir(), remove));
+        })
+        .then(function() {
+          return repository.openIndex();
+        })
+        .then(function(index) {
+          if (remove) {
+            index.removeByPath(remove);
+          }
+          index.addByPath(add);
+          index.write();
+
+          return index.writeTree();
+        })
+        .then(function(tree) {
+          return repository.createCommit("HEAD", signature, signature,
+            message, tree, parents);
+        })
+        .then(function(id) {
+          return repository.getCommit(id);
+        })
+        .then(function(commit) {
+          parents = [commit];
+          return commit;
+        });
+    }
+
+    function readHistory(commit, followRenames) {
+      return new Promise(function(resolve, reject) {
+        var paths = [];
+        var history = commit.historyStream({
+          path: "new.txt",
+          followRenames: followRenames
+        });
+
+        history.on("data", function(chunk) {
+          paths = paths.concat(chunk.paths);
+        });
+        history.on("end", function() {
+          resolve(paths);
+        });
+        history.on("error", reject);
+      });
+    }
+
+    return fse.remove(renamePath)
+      .then(function() {
+        return Repository.init(renamePath, 0);
+      })
+      .then(function(_repository) {
+        repository = _repository;
+        return commitFiles("add old.txt", null, "old.txt", content);
+      })
+      .then(function() {
+        return commitFiles("rename old.txt", "old.txt", "new.txt", content);
+      })
+      .then(function() {
+        return commitFiles("change new.txt", null, "new.txt",
+          content + "six\n");
+      })
+      .then(function(head) {
+        return Promise.all([readHistory(head, false), readHistory(head, true)]);
+      })
+      .then(function(histories) {
+        assert.deepEqual(histories[0], ["new.txt", "new.txt"]);
+        assert.deepEqual(histories[1], ["new.txt", "new.txt", "old.txt"]);
+      });
+  });
+
   it("can fetch the master branch HEAD", function() {
     var repository = this.repository;
 
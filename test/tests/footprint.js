@@ -0,0 +1,47 @@
+var assert = require("assert");
+var path = require("path");
+var local = path.join.bind(path, __dirname);
+
+describe("Footprint", function() {
+  var NodeGit = require("../../");
+  var Footprint = NodeGit.Footprint;
+  var Repository = NodeGit.Repository;
+
+  var reposPath = local("../repos/workdir");
+
+  beforeEach(function() {
+    var test = this;
+
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        test.repository = repository;
+        return repository.getMasterCommit();
+      })
+      .then(function(commit) {
+        test.commit = commit;
+      });
+  });
+
+  it("counts live wrappers per type", function() {
+    var before = Footprint.get().Tree || { created: 0 };
+
+    return this.commit.getTree()
+      .then(function(tree) {
+        var after = Footprint.get().Tree;
+
+        assert.equal(after.created, before.created + 1);
+        assert(after.live >= 1);
+        assert(after.bytes >= tree.entryCount());
+      });
+  });
+
+  it("charges a blob for its content", function() {
+    return this.commit.getEntry("README.md")
+      .then(function(entry) {
+        return entry.getBlob();
+      })
+      .then(function(blob) {
+        assert(Footprint.get().Blob.bytes >= blob.rawsize());
+      });
+  });
+});
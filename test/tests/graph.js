@@ -1,5 +1,8 @@
 var assert = require("assert");
 var path = require("path");
+var Promise = require("nodegit-promise");
+var promisify = require("promisify-node");
+var fse = promisify(require("fs-extra"));
 var local = path.join.bind(path, __dirname);
 
 describe("Graph", function() {
@@ -28,4 +31,89 @@ describe("Graph", function() {
       assert.equal(result.behind, 1);
     });
   });
+
+  it("can count many tips against one base", function() {
+    return Graph.aheadBehindMany(
+      this.repository,
+      "1729c73906bb8467f4095c2f4044083016b4dfde",
+      [
+        "32789a79e71fbc9e04d3eff7425e1771eb595150",
+        "1729c73906bb8467f4095c2f4044083016b4dfde"
+      ],
+      { mergeBases: true })
+    .then(function(results) {
+      assert.equal(results.length, 2);
+      assert.equal(results[0].ahead, 1);
+      assert.equal(results[0].behind, 1);
+      assert.equal(results[1].ahead, 0);
+      assert.equal(results[1].behind, 0);
+      assert.equal(results[1].mergeBase.toString(),
+        "1729c73906bb8467f4095c2f4044083016b4dfde");
+    });
+  });
+
+  describe("with a commit graph", function() {
+    beforeEach(function() {
+      return Graph.writeCommitGraph(this.repository);
+    });
+
+    after(function() {
+      return Repository.open(reposPath)
+        .then(function(repository) {
+          return fse.remove(
+            path.join(repository.path(), "nodegit-commit-graph"));
+        });
+    });
+
+    it("gets the same commits ahead/behind", function() {
+      return Graph.aheadBehind(
+        this.repository,
+        "32789a79e71fbc9e04d3eff7425e1771eb595150",
+        "1729c73906bb8467f4095c2f4044083016b4dfde")
+      .then(function(result) {
+        assert.equal(result.ahead, 1);
+        assert.equal(result.behind, 1);
+      });
+    });
+
+    it("gets the same merge base", function() {
+      var repository = this.repository;
+      var one = "32789a79e71fbc9e04d3eff7425e1771eb595150";
+      var two = "1729c73906bb8467f4095c2f4044083016b4dfde";
+
+      return repository.getCommit(one)
+        .then(function(commit) {
+          return NodeGit.Merge.base(repository, one, two)
+            .then(function(base) {
+              assert.equal(base.toString(), commit.parentId(0).toString());
+            });
+        });
+    });
+
+    it("counts many tips the same way", function() {
+      var one = "32789a79e71fbc9e04d3eff7425e1771eb595150";
+      var two = "1729c73906bb8467f4095c2f4044083016b4dfde";
+      var repository = this.repository;
+
+      return Promise.all([
+        Graph.aheadBehindMany(repository, two, [one, two], {
+          mergeBases: true
+        }),
+        NodeGit.Merge.base(repository, one, two)
+      ])
+      .then(function(results) {
+        var counts = results[0];
+
+        assert.equal(counts[0].ahead, 1);
+        assert.equal(counts[0].behind, 1);
+        assert.equal(counts[0].mergeBase.toString(), results[1].toString());
+        assert.equal(counts[1].ahead, 0);
+        assert.equal(counts[1].behind, 0);
+      });
+    });
+
+    it("can be brought up to date again", function() {
+      return Graph.writeCommitGraph(this.repository);
+    });
+  });
 });
@@ -1,5 +1,6 @@
 var assert = require("assert");
 var path = require("path");
+var Promise = require("nodegit-promise");
 var promisify = require("promisify-node");
 var fse = promisify(require("fs-extra"));
 var local = path.join.bind(path, __dirname);
@@ -27,6 +28,43 @@ describe("Merge", function() {
       });
   });
 
+  it("can find the merge base of many commits", function() {
+    var one = "32789a79e71fbc9e04d3eff7425e1771eb595150";
+    var two = "1729c73906bb8467f4095c2f4044083016b4dfde";
+
+    return NodeGit.Repository.open(local("../repos/workdir"))
+      .then(function(repository) {
+        return Promise.all([
+          NodeGit.Merge.base(repository, one, two),
+          NodeGit.Merge.baseMany(repository, [one, two]),
+          NodeGit.Merge.baseOctopus(repository, [one, two])
+        ]);
+      })
+      .then(function(bases) {
+        assert.equal(bases[1].toString(), bases[0].toString());
+        assert.equal(bases[2].toString(), bases[0].toString());
+      });
+  });
+
+  it("calls back with the merge base of many commits", function(done) {
+    var one = "32789a79e71fbc9e04d3eff7425e1771eb595150";
+    var two = "1729c73906bb8467f4095c2f4044083016b4dfde";
+
+    NodeGit.Repository.open(local("../repos/workdir"))
+      .then(function(repository) {
+        NodeGit.Merge.baseMany(repository, [one, two], function(error, many) {
+          assert.equal(error, null);
+
+          NodeGit.Merge.baseOctopus(repository, [one, two],
+            function(error, octopus) {
+              assert.equal(error, null);
+              assert.equal(octopus.toString(), many.toString());
+              done();
+            });
+        });
+      });
+  });
+
   it("can cleanly merge 2 files", function() {
     var ourFileName = "ourNewFile.txt";
     var theirFileName = "theirNewFile.txt";
@@ -42,6 +42,17 @@ describe("Odb", function() {
       });
   });
 
+  it("can provide object data as a buffer", function() {
+    return this.odb.read("32789a79e71fbc9e04d3eff7425e1771eb595150")
+      .then(function (object) {
+        var data = object.data();
+
+        assert.ok(Buffer.isBuffer(data));
+        assert.equal(data.length, object.size());
+        assert.equal(data.toString().slice(0, 5), "tree ");
+      });
+  });
+
   it("can write raw objects to git", function() {
     var obj = "test data";
     var odb = this.odb;
@@ -43,4 +43,31 @@ describe("Oid", function() {
         assert.equal(commits[0].toString(), oid);
       });
   });
+
+  it("can parse and format oids in bulk", function() {
+    var other = "32789a79e71fbc9e04d3eff7425e1771eb595150";
+    var ids = Oid.fromStrings([oid, other]);
+
+    assert.equal(ids.length, 40);
+    assert.deepEqual(Oid.toStrings(ids), [oid, other]);
+    assert.deepEqual(Oid.toStrings(Oid.at(ids, 1)), [other]);
+  });
+
+  it("rejects anything but hex strings in bulk", function() {
+    assert.throws(function() {
+      Oid.fromStrings([oid, "not an oid"]);
+    });
+  });
+
+  it("can pass a packed oid as a parameter", function() {
+    var ids = Oid.fromStrings([oid]);
+
+    return NodeGit.Repository.open(local("../repos/workdir"))
+      .then(function(repo) {
+        return repo.getCommit(Oid.at(ids, 0));
+      })
+      .then(function(commit) {
+        assert.equal(commit.id().toString(), oid);
+      });
+  });
 });
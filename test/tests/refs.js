@@ -36,6 +36,34 @@ describe("Reference", function() {
     assert.ok(this.reference instanceof Reference);
   });
 
+  it("returns a promise from a native async method", function() {
+    var promise = Reference.nameToId(this.repository, "refs/heads/master");
+
+    assert.equal(typeof promise.done, "function");
+
+    return promise.then(function(oid) {
+      assert.ok(oid instanceof NodeGit.Oid);
+    });
+  });
+
+  it("still accepts a node style callback", function(done) {
+    Reference.nameToId(this.repository, "refs/heads/master",
+      function(error, oid) {
+        assert.equal(error, null);
+        assert.ok(oid instanceof NodeGit.Oid);
+        done();
+      });
+  });
+
+  it("rejects instead of throwing on bad arguments", function() {
+    return Reference.nameToId(this.repository)
+      .then(function() {
+        assert.fail("a missing name should be rejected");
+      }, function(error) {
+        assert.ok(error instanceof Error);
+      });
+  });
+
   it("can determine if the reference is symbolic", function() {
     assert.equal(this.reference.isSymbolic(), false);
   });
@@ -1,5 +1,6 @@
 var assert = require("assert");
 var path = require("path");
+var Promise = require("nodegit-promise");
 var local = path.join.bind(path, __dirname);
 
 describe("Revwalk", function() {
@@ -43,6 +44,34 @@ describe("Revwalk", function() {
       });
   });
 
+  it("can get a batch of packed oids", function() {
+    var sha = this.commit.sha();
+
+    return this.walker.nextBatch(4)
+      .then(function(ids) {
+        var shas = Oid.toStrings(ids);
+
+        assert.equal(ids.length, 4 * 20);
+        assert.equal(shas[0], sha);
+        assert.equal(shas[3], "b8a94aefb22d0534cc0e5acf533989c13d8725dc");
+      });
+  });
+
+  it("returns a short batch at the end of the walk", function() {
+    var walker = this.walker;
+
+    return walker.nextBatch(100000)
+      .then(function(ids) {
+        assert(ids.length > 0);
+        assert(ids.length < 100000 * 20);
+
+        return walker.nextBatch(10);
+      })
+      .then(function(ids) {
+        assert.equal(ids.length, 0);
+      });
+  });
+
   it("can hide an object", function() {
     var test = this;
 
@@ -68,6 +97,51 @@ describe("Revwalk", function() {
       });
   });
 
+  it("can hide commits through a hide set", function() {
+    var walker = this.repository.createRevWalk();
+
+    walker.setFilter({ hide: ["b8a94aefb22d0534cc0e5acf533989c13d8725dc"] });
+    walker.push(this.commit.id());
+
+    return walker.nextMatching(walker.filter, 10)
+      .then(function(chunk) {
+        assert.equal(chunk.count, 3);
+        assert.equal(Oid.toStrings(chunk.ids)[2],
+          "95f695136203a372751c19b6353aeb5ae32ea40e");
+      });
+  });
+
+  it("can filter commits natively", function() {
+    var merges = this.repository.createRevWalk();
+    var nobody = this.repository.createRevWalk();
+
+    merges.setFilter({ minParents: 2 });
+    merges.push(this.commit.id());
+    nobody.setFilter({ author: "^nobody at all <", authorIgnoreCase: true });
+    nobody.push(this.commit.id());
+
+    assert.throws(function() {
+      nobody.setFilter({ author: /^nobody/ });
+    }, /not RegExps/);
+
+    return Promise.all([
+      this.walker.nextMetadata(1000),
+      merges.nextMatching(merges.filter, 1000),
+      nobody.nextMatching(nobody.filter, 1000)
+    ])
+    .then(function(chunks) {
+      var expected = chunks[0].parentCounts.filter(function(count) {
+        return count > 1;
+      });
+
+      assert.equal(chunks[1].count, expected.length);
+      chunks[1].parentCounts.forEach(function(count) {
+        assert(count > 1);
+      });
+      assert.equal(chunks[2].count, 0);
+    });
+  });
+
   it("can simplify to first parent", function() {
     var test = this;
 
@@ -0,0 +1,155 @@
+var assert = require("assert");
+var path = require("path");
+var local = path.join.bind(path, __dirname);
+
+describe("Scope", function() {
+  var NodeGit = require("../../");
+  var Commit = NodeGit.Commit;
+  var Oid = NodeGit.Oid;
+  var Repository = NodeGit.Repository;
+  var Scope = NodeGit.Scope;
+
+  var reposPath = local("../repos/workdir");
+
+  beforeEach(function() {
+    var test = this;
+
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        test.repository = repository;
+      });
+  });
+
+  it("frees what was looked up once the scope ends", function() {
+    var commit;
+
+    return this.repository.scope(function(repository, scope) {
+        return repository.getMasterCommit()
+          .then(function(master) {
+            commit = master;
+            assert(scope.size() > 0);
+
+            return commit.sha();
+          });
+      })
+      .then(function(sha) {
+        assert.equal(sha.length, 40);
+        assert.throws(function() {
+          commit.sha();
+        }, /already been freed/);
+      });
+  });
+
+  it("disposes of its objects when fn fails", function() {
+    var repository;
+
+    return this.repository.scope(function(scoped) {
+        repository = scoped;
+        throw new Error("failed");
+      })
+      .then(function() {
+        assert.fail("should have rejected");
+      }, function(error) {
+        assert.equal(error.message, "failed");
+        assert.throws(function() {
+          repository.path();
+        }, /already been freed/);
+      });
+  });
+
+  it("takes objects from the repository it was opened from", function() {
+    var outer;
+
+    return this.repository.getMasterCommit()
+      .then(function(commit) {
+        outer = commit;
+
+        return this.repository.scope(function(repository) {
+          // The scoped repository is opened again from the same path.
+          assert.notEqual(repository, this.repository);
+          assert.equal(repository.path(), this.repository.path());
+
+          return repository.getCommit(outer.id())
+            .then(function(commit) {
+              assert.equal(commit.sha(), outer.sha());
+
+              return NodeGit.Graph.aheadBehind(repository, outer.id(),
+                commit.parentId(0));
+            });
+        }.bind(this));
+      }.bind(this))
+      .then(function(result) {
+        assert(result.ahead > 0);
+        assert.equal(result.behind, 0);
+        assert.equal(outer.sha().length, 40);
+      });
+  });
+
+  it("leaves objects made outside of it alone", function() {
+    var repository = this.repository;
+    var scope = new Scope();
+
+    return repository.getMasterCommit()
+      .then(function(master) {
+        return scope.run(function() {
+          return Commit.lookup(repository, master.id());
+        });
+      })
+      .then(function(commit) {
+        assert(scope.size() > 0);
+        scope.dispose();
+
+        assert.equal(scope.size(), 0);
+        assert.throws(function() {
+          commit.sha();
+        }, /already been freed/);
+        assert.equal(repository.path(), path.join(reposPath, ".git/"));
+      });
+  });
+
+  it("waits for calls still running before disposing", function() {
+    var repository = this.repository;
+    var scope = new Scope();
+    var other = new Scope();
+    var scoped;
+    var id;
+
+    return scope.run(function() {
+        return Repository.open(reposPath);
+      })
+      .then(function(_scoped) {
+        scoped = _scoped;
+        return repository.getMasterCommit();
+      })
+      .then(function(master) {
+        var sha = master.sha();
+
+        id = other.run(function() {
+          return Oid.fromString(sha);
+        });
+
+        var lookup = Commit.lookup(scoped, id);
+
+        scope.dispose();
+        other.dispose();
+
+        // The lookup uses both scopes until it is done.
+        assert.equal(scoped.path(), path.join(reposPath, ".git/"));
+        assert.equal(id.allocfmt(), sha);
+
+        return lookup;
+      })
+      .then(function(commit) {
+        assert.throws(function() {
+          commit.sha();
+        }, /already been freed/);
+        assert.throws(function() {
+          scoped.path();
+        }, /already been freed/);
+        assert.throws(function() {
+          id.allocfmt();
+        }, /already been freed/);
+        assert.equal(repository.path(), path.join(reposPath, ".git/"));
+      });
+  });
+});
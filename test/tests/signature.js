@@ -31,6 +31,18 @@ describe("Signature", function() {
     assert.equal(signature.when().offset(), 60);
   });
 
+  it("can be read into a plain object", function() {
+    var signature = Signature.create(name, email, arbitraryDate,
+      timezoneOffset);
+    var object = signature.toObject();
+
+    assert.equal(object.name, name);
+    assert.equal(object.email, email);
+    assert.equal(object.when.time, arbitraryDate);
+    assert.equal(object.when.offset, timezoneOffset);
+    assert.equal(JSON.stringify(signature), JSON.stringify(object));
+  });
+
   it("can be created now", function() {
     var signature = Signature.now(name, email);
     var now = new Date();
@@ -0,0 +1,64 @@
+var assert = require("assert");
+var path = require("path");
+var local = path.join.bind(path, __dirname);
+
+describe("Stats", function() {
+  var NodeGit = require("../../");
+  var Oid = NodeGit.Oid;
+  var Reference = NodeGit.Reference;
+  var Repository = NodeGit.Repository;
+  var Stats = NodeGit.Stats;
+
+  var reposPath = local("../repos/workdir");
+  var sha = "fce88902e66c72b5b93e75bdb5ae717038b221f6";
+
+  beforeEach(function() {
+    this.wasEnabled = Stats.isEnabled();
+    Stats.reset();
+  });
+
+  afterEach(function() {
+    if (this.wasEnabled) {
+      Stats.enable();
+    }
+    else {
+      Stats.disable();
+    }
+  });
+
+  it("records nothing while disabled", function() {
+    Stats.disable();
+    Oid.fromString(sha);
+
+    assert.equal(Stats.get()["Oid.fromString"], undefined);
+  });
+
+  it("records how long a sync call blocked", function() {
+    Stats.enable();
+    Oid.fromString(sha);
+    Oid.fromString(sha);
+
+    var stats = Stats.get()["Oid.fromString"];
+
+    assert.equal(stats.calls, 2);
+    assert.equal(stats.blocking.count, 2);
+    assert(stats.blocking.max >= stats.blocking.mean);
+  });
+
+  it("splits an async call into wait, execute and complete", function() {
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        Stats.enable();
+        return Reference.nameToId(repository, "refs/heads/master");
+      })
+      .then(function() {
+        var stats = Stats.get()["Reference.nameToId"];
+
+        assert.equal(stats.calls, 1);
+        assert.equal(stats.queueWait.count, 1);
+        assert.equal(stats.execute.count, 1);
+        assert.equal(stats.complete.count, 1);
+        assert.equal(stats.execute.buckets.length, 24);
+      });
+  });
+});
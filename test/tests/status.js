@@ -108,4 +108,42 @@ describe("Status", function() {
 
       });
   });
+
+  it("can deliver statuses in batches", function() {
+    var repo = this.repository;
+    var fileNames = ["batched-1.file", "batched-2.file", "batched-3.file"];
+    var batches = [];
+    var statusCallback = NodeGit.Utils.batched(function(entries) {
+      batches.push(entries);
+    }, { size: 2, wait: 10000000 });
+
+    var opts = {
+      flags: Status.OPT.INCLUDE_UNTRACKED
+    };
+
+    return Promise.all(fileNames.map(function(fileName) {
+      return fse.writeFile(path.join(repo.workdir(), fileName), fileName);
+    }))
+      .then(function() {
+        return Status.foreachExt(repo, opts, statusCallback);
+      })
+      .then(function() {
+        var paths = batches.reduce(function(all, entries) {
+          return all.concat(entries.map(function(entry) {
+            return entry[0];
+          }));
+        }, []);
+
+        assert.equal(batches.length, 2);
+        assert.deepEqual(paths.sort(), fileNames);
+        batches.forEach(function(entries) {
+          entries.forEach(function(entry) {
+            assert.equal(entry[1], Status.STATUS.WT_NEW);
+          });
+        });
+      })
+      .then(function() {
+        return exec("git clean -xdf", {cwd: reposPath});
+      });
+  });
 });
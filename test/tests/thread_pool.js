@@ -0,0 +1,224 @@
+var assert = require("assert");
+var path = require("path");
+var Promise = require("nodegit-promise");
+var promisify = require("promisify-node");
+var fse = promisify(require("fs-extra"));
+var local = path.join.bind(path, __dirname);
+
+describe("ThreadPool", function() {
+  var NodeGit = require("../../");
+  var Reference = NodeGit.Reference;
+  var Repository = NodeGit.Repository;
+  var Status = NodeGit.Status;
+  var Tag = NodeGit.Tag;
+  var ThreadPool = NodeGit.ThreadPool;
+
+  var reposPath = local("../repos/workdir");
+
+  beforeEach(function() {
+    this.originalSize = ThreadPool.getSize();
+  });
+
+  afterEach(function() {
+    ThreadPool.setSize(this.originalSize);
+  });
+
+  it("can be resized", function() {
+    ThreadPool.setSize(2);
+    assert.equal(ThreadPool.getSize(), 2);
+    assert.equal(ThreadPool.getStats().size, 2);
+  });
+
+  it("rejects a size below one", function() {
+    assert.throws(function() {
+      ThreadPool.setSize(0);
+    });
+  });
+
+  it("counts interactive and bulk work separately", function() {
+    var before = ThreadPool.getStats();
+
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        return Status.foreach(repository, function() {});
+      })
+      .then(function() {
+        var after = ThreadPool.getStats();
+
+        assert.equal(
+          after.interactive.completed,
+          before.interactive.completed + 1
+        );
+        assert.equal(after.bulk.completed, before.bulk.completed + 1);
+        assert.equal(after.interactive.queued, 0);
+        assert.equal(after.bulk.queued, 0);
+        assert(after.threads >= 1);
+      });
+  });
+
+  it("still runs bulk work with a single thread", function() {
+    ThreadPool.setSize(1);
+
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        return Status.foreach(repository, function() {});
+      });
+  });
+
+  it("runs work queued from a progress callback with one thread", function() {
+    var clonePath = local("../repos/thread-pool-clone");
+    var opens = 0;
+
+    ThreadPool.setSize(1);
+
+    var opts = {
+      checkoutOpts: {
+        checkoutStrategy: NodeGit.Checkout.STRATEGY.SAFE_CREATE,
+        progressCb: function() {
+          // The clone holds the only thread until this settles.
+          return Repository.open(reposPath).then(function() {
+            opens++;
+          });
+        }
+      }
+    };
+
+    return fse.remove(clonePath)
+      .then(function() {
+        return NodeGit.Clone(reposPath, clonePath, opts);
+      })
+      .then(function() {
+        assert(opens > 0);
+        assert(ThreadPool.getStats().threads > 1);
+
+        return fse.remove(clonePath);
+      });
+  });
+
+  it("runs a read queued behind a write on the same repo after it", function() {
+    var name = "thread-pool-ordering";
+    var repository;
+    var commit;
+
+    return Repository.open(reposPath)
+      .then(function(_repository) {
+        repository = _repository;
+        return repository.getMasterCommit();
+      })
+      .then(function(_commit) {
+        commit = _commit;
+
+        // Neither call waits for the other in JS; the pool has to keep the
+        // lookup behind the tag write.
+        return Promise.all([
+          Tag.createLightweight(repository, name, commit, 0),
+          Reference.nameToId(repository, "refs/tags/" + name)
+        ]);
+      })
+      .then(function(results) {
+        assert.equal(results[1].toString(), commit.id().toString());
+
+        var stats = ThreadPool.getStats();
+        assert.equal(stats.blocked, 0);
+        assert.equal(stats.repositories, 0);
+
+        Tag.delete(repository, name);
+      });
+  });
+
+  it("lets a callback's own work past a write queued behind it", function() {
+    var name = "thread-pool-callback";
+    var fileName = "thread-pool-callback.txt";
+    var repository;
+    var commit;
+    var lookups = 0;
+
+    return Repository.open(reposPath)
+      .then(function(_repository) {
+        repository = _repository;
+        return fse.writeFile(path.join(repository.workdir(), fileName), "");
+      })
+      .then(function() {
+        return repository.getMasterCommit();
+      })
+      .then(function(_commit) {
+        commit = _commit;
+
+        var opts = { flags: Status.OPT.INCLUDE_UNTRACKED };
+        var statuses = Status.foreachExt(repository, opts, function() {
+          // The status job holds the repository until this settles, and the
+          // tag write is already queued behind it.
+          return Reference.nameToId(repository, "HEAD").then(function() {
+            lookups++;
+          });
+        });
+
+        return Promise.all([
+          statuses,
+          Tag.createLightweight(repository, name, commit, 0)
+        ]);
+      })
+      .then(function() {
+        assert(lookups > 0);
+        assert.equal(ThreadPool.getStats().repositories, 0);
+
+        Tag.delete(repository, name);
+        return fse.remove(path.join(repository.workdir(), fileName));
+      });
+  });
+
+  it("keeps other work out while a job waits for its callback", function() {
+    var name = "thread-pool-outside";
+    var fileName = "thread-pool-outside.txt";
+    var repository;
+    var commit;
+    var order = [];
+    var tagged;
+
+    return Repository.open(reposPath)
+      .then(function(_repository) {
+        repository = _repository;
+        return fse.writeFile(path.join(repository.workdir(), fileName), "");
+      })
+      .then(function() {
+        return repository.getMasterCommit();
+      })
+      .then(function(_commit) {
+        commit = _commit;
+
+        var opts = { flags: Status.OPT.INCLUDE_UNTRACKED };
+        var statuses = Status.foreachExt(repository, opts, function() {
+          if (tagged) {
+            return;
+          }
+
+          return new Promise(function(resolve) {
+            // Queued from a timer rather than the callback, so the write is
+            // not part of the status job and has to wait for it.
+            setTimeout(function() {
+              tagged = Tag.createLightweight(repository, name, commit, 0)
+                .then(function() {
+                  order.push("tag");
+                });
+
+              setTimeout(function() {
+                order.push("callback");
+                resolve();
+              }, 50);
+            }, 0);
+          });
+        });
+
+        return statuses;
+      })
+      .then(function() {
+        return tagged;
+      })
+      .then(function() {
+        assert.deepEqual(order, ["callback", "tag"]);
+
+        Tag.delete(repository, name);
+        return fse.remove(path.join(repository.workdir(), fileName));
+      });
+  });
+});
@@ -0,0 +1,90 @@
+var assert = require("assert");
+var path = require("path");
+var Promise = require("nodegit-promise");
+var local = path.join.bind(path, __dirname);
+
+describe("Trace", function() {
+  var NodeGit = require("../../");
+  var Reference = NodeGit.Reference;
+  var Repository = NodeGit.Repository;
+  var Trace = NodeGit.Trace;
+
+  var reposPath = local("../repos/workdir");
+
+  beforeEach(function() {
+    Trace.drain();
+    Trace.dropped();
+  });
+
+  afterEach(function() {
+    Trace.set(Trace.LEVEL.NONE);
+    Trace.drain();
+    Trace.dropped();
+  });
+
+  it("can be turned on and off", function() {
+    Trace.set(Trace.LEVEL.TRACE);
+    Trace.set(Trace.LEVEL.NONE);
+  });
+
+  it("drains messages traced by a worker thread", function() {
+    Trace.set(Trace.LEVEL.DEBUG);
+
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        return repository.getMasterCommit();
+      })
+      .then(function() {
+        var messages = Trace.drain();
+        var debug = messages.filter(function(message) {
+          return message.level == Trace.LEVEL.DEBUG;
+        });
+
+        // The thread pool traces every job it finishes at DEBUG.
+        assert(debug.length > 0);
+        messages.forEach(function(message) {
+          assert(message.level <= Trace.LEVEL.DEBUG);
+          assert.equal(typeof message.time, "number");
+          assert.equal(typeof message.message, "string");
+        });
+
+        assert.equal(Trace.drain().length, 0);
+        assert.equal(Trace.dropped(), 0);
+      });
+  });
+
+  it("counts messages dropped once the buffer is full", function() {
+    var lookups = [];
+
+    Trace.set(Trace.LEVEL.TRACE);
+
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        // Two messages a job, which is more than the 1024 the buffer holds.
+        for (var i = 0; i < 600; i++) {
+          lookups.push(Reference.nameToId(repository, "HEAD"));
+        }
+
+        return Promise.all(lookups);
+      })
+      .then(function() {
+        assert.equal(Trace.drain().length, 1024);
+        assert(Trace.dropped() > 0);
+        assert.equal(Trace.dropped(), 0);
+      });
+  });
+
+  it("requires a level", function() {
+    assert.throws(function() {
+      Trace.set();
+    });
+  });
+
+  it("stops watching with a last drain", function() {
+    var stop = Trace.watch(function(messages) {
+      assert(Array.isArray(messages));
+    }, 10);
+
+    stop();
+  });
+});
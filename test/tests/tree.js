@@ -0,0 +1,125 @@
+var assert = require("assert");
+var path = require("path");
+var Promise = require("nodegit-promise");
+var local = path.join.bind(path, __dirname);
+
+describe("Tree", function() {
+  var NodeGit = require("../../");
+  var Repository = NodeGit.Repository;
+
+  var reposPath = local("../repos/workdir");
+  var oid = "fce88902e66c72b5b93e75bdb5ae717038b221f6";
+
+  var TREE = 16384;
+
+  function readAll(stream) {
+    return new Promise(function(resolve, reject) {
+      var entries = [];
+
+      stream.on("data", function(chunk) {
+        assert.equal(chunk.ids.length, chunk.count * 20);
+        assert.equal(chunk.paths.length, chunk.count);
+        assert.equal(chunk.modes.length, chunk.count);
+
+        for (var i = 0; i < chunk.count; i++) {
+          entries.push({
+            path: chunk.paths[i],
+            sha: NodeGit.Oid.at(chunk.ids, i).toString(),
+            mode: chunk.modes[i]
+          });
+        }
+      });
+
+      stream.on("end", function() {
+        resolve(entries);
+      });
+
+      stream.on("error", reject);
+    });
+  }
+
+  beforeEach(function() {
+    var test = this;
+
+    return Repository.open(reposPath)
+      .then(function(repository) {
+        return repository.getCommit(oid);
+      })
+      .then(function(commit) {
+        return commit.getTree();
+      })
+      .then(function(tree) {
+        test.tree = tree;
+      });
+  });
+
+  it("can stream its blobs", function() {
+    var tree = this.tree;
+
+    return readAll(tree.walkStream({ chunkSize: 50 }))
+      .then(function(entries) {
+        assert.equal(entries.length, 198);
+        entries.forEach(function(entry) {
+          assert.notEqual(entry.mode, TREE);
+        });
+
+        return tree.getEntry(entries[0].path).then(function(entry) {
+          assert.equal(entry.sha(), entries[0].sha);
+        });
+      });
+  });
+
+  it("can stream trees before or after what is in them", function() {
+    var tree = this.tree;
+
+    return Promise.all([
+      readAll(tree.walkStream({ blobsOnly: false })),
+      readAll(tree.walkStream({ blobsOnly: false, postOrder: true }))
+    ])
+    .then(function(walks) {
+      var pre = walks[0].map(function(entry) { return entry.path; });
+      var post = walks[1].map(function(entry) { return entry.path; });
+
+      assert(pre.length > 198);
+      assert.equal(post.length, pre.length);
+
+      walks[0].forEach(function(entry) {
+        if (entry.mode !== TREE) {
+          return;
+        }
+
+        var inside = pre.filter(function(other) {
+          return other.indexOf(entry.path + "/") === 0;
+        });
+
+        inside.forEach(function(other) {
+          assert(pre.indexOf(entry.path) < pre.indexOf(other));
+          assert(post.indexOf(entry.path) > post.indexOf(other));
+        });
+      });
+    });
+  });
+
+  it("can stream only what is under some paths", function() {
+    var tree = this.tree;
+
+    return readAll(tree.walkStream())
+      .then(function(all) {
+        var nested = all.filter(function(entry) {
+          return entry.path.indexOf("/") !== -1;
+        });
+        var directory = nested[0].path.split("/")[0];
+        var expected = all.filter(function(entry) {
+          return entry.path.indexOf(directory + "/") === 0
+            || entry.path === "README.md";
+        });
+
+        return readAll(tree.walkStream({
+          paths: [directory + "/", "README.md"]
+        }))
+        .then(function(entries) {
+          assert.deepEqual(entries, expected);
+        });
+      });
+  });
+});